@@ -1,5 +1,11 @@
 add_compile_definitions(PPC_PATH_TO_PROJECT="${CMAKE_CURRENT_SOURCE_DIR}")
 
+# Build description recorded in structured performance results
+string(TOUPPER "${CMAKE_BUILD_TYPE}" PPC_BUILD_TYPE_UPPER)
+add_compile_definitions(
+  PPC_BUILD_TYPE="${CMAKE_BUILD_TYPE}"
+  PPC_CXX_FLAGS="${CMAKE_CXX_FLAGS} ${CMAKE_CXX_FLAGS_${PPC_BUILD_TYPE_UPPER}}")
+
 macro(SUBDIRLIST result curdir)
   file(
     GLOB children
@@ -25,3 +31,19 @@ if(USE_PERF_TESTS)
   message(STATUS "Enable performance tests")
   add_compile_definitions(USE_PERF_TESTS)
 endif(USE_PERF_TESTS)
+
+option(USE_ALLOC_HOOKS "Count heap allocations by replacing global operator new/delete" OFF)
+if(USE_ALLOC_HOOKS)
+  message(STATUS "Enable allocation hooks")
+endif(USE_ALLOC_HOOKS)
+
+option(USE_MPI_PROFILING "Profile MPI calls per test through the PMPI interface" OFF)
+if(USE_MPI_PROFILING)
+  message(STATUS "Enable MPI profiling")
+endif(USE_MPI_PROFILING)
+
+option(USE_HUGE_PAGES "Back large ppc::util::AlignedAllocator buffers with huge pages" OFF)
+if(USE_HUGE_PAGES)
+  message(STATUS "Enable huge pages for aligned allocations")
+  add_compile_definitions(PPC_USE_HUGE_PAGES)
+endif(USE_HUGE_PAGES)
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+
+#include "comm/include/partition.hpp"
+
+namespace ppc::comm {
+
+/// @brief Returns the MPI datatype of @p T.
+/// @details Arithmetic types map to the predefined datatypes; any other trivially copyable type maps to a contiguous
+/// byte type that is committed on first use and lives until MPI_Finalize.
+template <typename T>
+MPI_Datatype GetMpiType() {
+  static_assert(std::is_trivially_copyable_v<T>, "MPI buffers must hold trivially copyable elements");
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<U, double>) {
+    return MPI_DOUBLE;
+  } else if constexpr (std::is_same_v<U, float>) {
+    return MPI_FLOAT;
+  } else if constexpr (std::is_same_v<U, long double>) {
+    return MPI_LONG_DOUBLE;
+  } else if constexpr (std::is_same_v<U, std::complex<double>>) {
+    return MPI_CXX_DOUBLE_COMPLEX;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return MPI_CHAR;
+  } else if constexpr (std::is_same_v<U, bool>) {
+    return MPI_CXX_BOOL;
+  } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+    if constexpr (sizeof(U) == 1) {
+      return MPI_INT8_T;
+    } else if constexpr (sizeof(U) == 2) {
+      return MPI_INT16_T;
+    } else if constexpr (sizeof(U) == 4) {
+      return MPI_INT32_T;
+    } else {
+      return MPI_INT64_T;
+    }
+  } else if constexpr (std::is_integral_v<U>) {
+    if constexpr (sizeof(U) == 1) {
+      return MPI_UINT8_T;
+    } else if constexpr (sizeof(U) == 2) {
+      return MPI_UINT16_T;
+    } else if constexpr (sizeof(U) == 4) {
+      return MPI_UINT32_T;
+    } else {
+      return MPI_UINT64_T;
+    }
+  } else {
+    static const MPI_Datatype kType = [] {
+      MPI_Datatype type = MPI_DATATYPE_NULL;
+      MPI_Type_contiguous(static_cast<int>(sizeof(U)), MPI_BYTE, &type);
+      MPI_Type_commit(&type);
+      return type;
+    }();
+    return kType;
+  }
+}
+
+namespace detail {
+
+void Scatterv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+              int root, MPI_Comm comm);
+void Gatherv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+             int root, MPI_Comm comm);
+void Allgatherv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+                MPI_Comm comm);
+MPI_Request Iallgatherv(const void *send, void *recv, MPI_Datatype type, const PartitionPlan &plan, MPI_Comm comm);
+
+}  // namespace detail
+
+/// @brief Distributes the global buffer @p send of @p root according to @p plan.
+/// @details Every rank receives GetCount(rank) elements into @p recv, its segments stored back to back. @p send is
+/// only read on @p root. Counts go through the MPI-4 large-count collectives when the library provides them; with
+/// MPI-3 a plan larger than INT_MAX elements throws std::overflow_error instead of silently truncating.
+/// @throws std::invalid_argument if the plan does not have one part per rank of @p comm.
+template <typename T>
+void Scatterv(const T *send, T *recv, const PartitionPlan &plan, int root, MPI_Comm comm) {
+  detail::Scatterv(send, recv, sizeof(T), GetMpiType<T>(), plan, root, comm);
+}
+
+/// @brief Collects the local buffers @p send (GetCount(rank) elements each) into the global buffer @p recv of
+/// @p root, the inverse of Scatterv().
+template <typename T>
+void Gatherv(const T *send, T *recv, const PartitionPlan &plan, int root, MPI_Comm comm) {
+  detail::Gatherv(send, recv, sizeof(T), GetMpiType<T>(), plan, root, comm);
+}
+
+/// @brief Like Gatherv(), but every rank receives the global buffer.
+template <typename T>
+void Allgatherv(const T *send, T *recv, const PartitionPlan &plan, MPI_Comm comm) {
+  detail::Allgatherv(send, recv, sizeof(T), GetMpiType<T>(), plan, comm);
+}
+
+/// @brief Nonblocking Allgatherv(); complete the returned request with MPI_Wait before touching @p send or @p recv.
+/// @details Lets a rank compute the next step while its block travels, e.g. a solver sweeping with the previous
+/// values of the other ranks.
+/// @throws std::invalid_argument if @p plan is not contiguous, since packed segments could only be unpacked after
+/// completion.
+template <typename T>
+MPI_Request Iallgatherv(const T *send, T *recv, const PartitionPlan &plan, MPI_Comm comm) {
+  return detail::Iallgatherv(send, recv, GetMpiType<T>(), plan, comm);
+}
+
+}  // namespace ppc::comm
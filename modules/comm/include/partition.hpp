@@ -0,0 +1,113 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ppc::comm {
+
+/// @brief Range of global elements [offset, offset + count) owned by one part.
+struct Segment {
+  std::int64_t offset = 0;
+  std::int64_t count = 0;
+};
+
+/// @brief Assignment of `total` units of `unit` elements each to `parts` ranks.
+/// @details Counts and displacements are in elements and ready for the v-collectives: displacements index the
+/// rank-major packed buffer, which for contiguous plans (block, weighted) is the global buffer itself. Block-cyclic
+/// plans own several segments per part; the wrappers in collectives.hpp pack and unpack them. A plan computes all
+/// arrays once, so reusing it costs no allocation. Prefer the cached GetBlockPlan() and friends inside RunImpl.
+class PartitionPlan {
+ public:
+  /// @brief Contiguous blocks; the first total % parts parts get one unit more.
+  static PartitionPlan Block(std::int64_t total, int parts, std::int64_t unit = 1);
+  /// @brief Blocks of @p block_size units dealt out round-robin.
+  static PartitionPlan BlockCyclic(std::int64_t total, int parts, std::int64_t block_size, std::int64_t unit = 1);
+  /// @brief Contiguous blocks proportional to @p weights, one weight per part; rounding remainders go to the
+  /// parts with the largest fractional share.
+  static PartitionPlan Weighted(std::int64_t total, std::span<const double> weights, std::int64_t unit = 1);
+
+  [[nodiscard]] int GetParts() const {
+    return static_cast<int>(counts_.size());
+  }
+  /// @brief Returns the number of elements (units times unit size) of all parts.
+  [[nodiscard]] std::int64_t GetTotal() const {
+    return total_;
+  }
+  [[nodiscard]] std::int64_t GetUnit() const {
+    return unit_;
+  }
+  [[nodiscard]] bool IsContiguous() const {
+    return contiguous_;
+  }
+
+  /// @brief Returns the number of elements of @p part.
+  [[nodiscard]] std::int64_t GetCount(int part) const {
+    return counts_[static_cast<std::size_t>(part)];
+  }
+  /// @brief Returns the offset of @p part in the packed buffer, which is the global offset for contiguous plans.
+  [[nodiscard]] std::int64_t GetDispl(int part) const {
+    return displs_[static_cast<std::size_t>(part)];
+  }
+  /// @brief Returns the number of units (e.g. matrix rows) of @p part.
+  [[nodiscard]] std::int64_t GetUnitCount(int part) const {
+    return GetCount(part) / unit_;
+  }
+  /// @brief Returns the first unit of @p part. Only meaningful for contiguous plans.
+  [[nodiscard]] std::int64_t GetUnitOffset(int part) const {
+    return GetDispl(part) / unit_;
+  }
+  /// @brief Returns the global element ranges of @p part in the order they are stored locally.
+  [[nodiscard]] std::span<const Segment> GetSegments(int part) const;
+
+  /// @brief Returns whether every count and displacement fits the int arguments of MPI-3 collectives.
+  [[nodiscard]] bool FitsInt() const {
+    return fits_int_;
+  }
+  /// @brief Counts as int for MPI-3 collectives. Empty if FitsInt() is false.
+  [[nodiscard]] const std::vector<int> &GetIntCounts() const {
+    return int_counts_;
+  }
+  [[nodiscard]] const std::vector<int> &GetIntDispls() const {
+    return int_displs_;
+  }
+#if MPI_VERSION >= 4
+  /// @brief Counts for the MPI-4 large-count collectives (MPI_Scatterv_c and friends).
+  [[nodiscard]] const std::vector<MPI_Count> &GetLargeCounts() const {
+    return large_counts_;
+  }
+  [[nodiscard]] const std::vector<MPI_Aint> &GetLargeDispls() const {
+    return large_displs_;
+  }
+#endif
+
+ private:
+  PartitionPlan(std::int64_t unit, bool contiguous, std::vector<std::vector<Segment>> unit_segments);
+
+  std::int64_t total_ = 0;
+  std::int64_t unit_ = 1;
+  bool contiguous_ = true;
+  bool fits_int_ = true;
+  std::vector<std::int64_t> counts_;
+  std::vector<std::int64_t> displs_;
+  std::vector<Segment> segments_;
+  /// Index of the first segment of every part plus one past the last
+  std::vector<std::size_t> segment_begin_;
+  std::vector<int> int_counts_;
+  std::vector<int> int_displs_;
+#if MPI_VERSION >= 4
+  std::vector<MPI_Count> large_counts_;
+  std::vector<MPI_Aint> large_displs_;
+#endif
+};
+
+/// @brief Returns a process-wide cached PartitionPlan::Block(); the reference stays valid until exit.
+const PartitionPlan &GetBlockPlan(std::int64_t total, int parts, std::int64_t unit = 1);
+/// @brief Returns a process-wide cached PartitionPlan::BlockCyclic().
+const PartitionPlan &GetBlockCyclicPlan(std::int64_t total, int parts, std::int64_t block_size, std::int64_t unit = 1);
+/// @brief Returns a process-wide cached PartitionPlan::Weighted().
+const PartitionPlan &GetWeightedPlan(std::int64_t total, std::span<const double> weights, std::int64_t unit = 1);
+
+}  // namespace ppc::comm
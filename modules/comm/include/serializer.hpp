@@ -0,0 +1,323 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ppc::comm {
+
+namespace detail {
+
+/// Throws before a read of @p count bytes at @p in would run past @p end
+inline void RequireBytes(const std::byte *in, const std::byte *end, std::size_t count) {
+  if (static_cast<std::size_t>(end - in) < count) {
+    throw std::invalid_argument("Packed buffer ends before the unpacked value");
+  }
+}
+
+}  // namespace detail
+
+/// @brief Byte layout of a value for MPI transfer.
+/// @details Trivially copyable types are copied as raw bytes. Specializations handle std::basic_string, std::vector,
+/// std::array, std::pair, std::tuple and std::variant recursively, so nested inputs such as
+/// std::vector<std::vector<int>> or std::tuple<std::string, std::string> pack into one contiguous buffer with a
+/// std::uint64_t length in front of every container. Ranks of one run share the ABI, so no byte order conversion is
+/// done. Read() gets the end of the buffer and throws std::invalid_argument before it would read past it.
+template <typename T>
+struct Serializer {
+  static_assert(std::is_trivially_copyable_v<T>, "Type has no ppc::comm::Serializer specialization");
+
+  static std::size_t Size(const T & /*value*/) {
+    return sizeof(T);
+  }
+  static void Write(const T &value, std::byte *&out) {
+    std::memcpy(out, &value, sizeof(T));
+    out += sizeof(T);
+  }
+  static void Read(T &value, const std::byte *&in, const std::byte *end) {
+    detail::RequireBytes(in, end, sizeof(T));
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+  }
+};
+
+namespace detail {
+
+inline void WriteLength(std::size_t length, std::byte *&out) {
+  Serializer<std::uint64_t>::Write(static_cast<std::uint64_t>(length), out);
+}
+
+inline std::size_t ReadLength(const std::byte *&in, const std::byte *end) {
+  std::uint64_t length = 0;
+  Serializer<std::uint64_t>::Read(length, in, end);
+  return static_cast<std::size_t>(length);
+}
+
+/// Elements that are written as one block instead of one by one
+template <typename T>
+constexpr bool kIsBlockCopyable = std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>;
+
+/// Serializer of a sequence stored as a length followed by its elements
+template <typename Container>
+struct SequenceSerializer {
+  using Element = typename Container::value_type;
+
+  static std::size_t Size(const Container &value) {
+    if constexpr (kIsBlockCopyable<Element>) {
+      return sizeof(std::uint64_t) + (value.size() * sizeof(Element));
+    } else {
+      std::size_t size = sizeof(std::uint64_t);
+      for (const auto &element : value) {
+        size += Serializer<Element>::Size(element);
+      }
+      return size;
+    }
+  }
+  static void Write(const Container &value, std::byte *&out) {
+    WriteLength(value.size(), out);
+    if constexpr (kIsBlockCopyable<Element>) {
+      if (!value.empty()) {
+        std::memcpy(out, value.data(), value.size() * sizeof(Element));
+        out += value.size() * sizeof(Element);
+      }
+    } else if constexpr (std::is_same_v<Element, bool>) {
+      for (const bool flag : value) {
+        Serializer<bool>::Write(flag, out);
+      }
+    } else {
+      for (const auto &element : value) {
+        Serializer<Element>::Write(element, out);
+      }
+    }
+  }
+  static void Read(Container &value, const std::byte *&in, const std::byte *end) {
+    const std::size_t length = ReadLength(in, end);
+    // Every element takes at least one byte, so a corrupt length fails here instead of in resize()
+    const std::size_t min_element_size = kIsBlockCopyable<Element> ? sizeof(Element) : 1;
+    if (length > static_cast<std::size_t>(end - in) / min_element_size) {
+      throw std::invalid_argument("Packed buffer ends before the unpacked value");
+    }
+    value.resize(length);
+    if constexpr (kIsBlockCopyable<Element>) {
+      if (!value.empty()) {
+        std::memcpy(value.data(), in, value.size() * sizeof(Element));
+        in += value.size() * sizeof(Element);
+      }
+    } else if constexpr (std::is_same_v<Element, bool>) {
+      for (auto &&element : value) {
+        bool flag = false;
+        Serializer<bool>::Read(flag, in, end);
+        element = flag;
+      }
+    } else {
+      for (auto &element : value) {
+        Serializer<Element>::Read(element, in, end);
+      }
+    }
+  }
+};
+
+/// Serializer of a fixed set of members reachable through std::apply
+template <typename Product>
+struct ProductSerializer {
+  static std::size_t Size(const Product &value) {
+    return std::apply([](const auto &...members) { return (std::size_t{0} + ... + GetSize(members)); }, value);
+  }
+  static void Write(const Product &value, std::byte *&out) {
+    std::apply([&out](const auto &...members) { (WriteMember(members, out), ...); }, value);
+  }
+  static void Read(Product &value, const std::byte *&in, const std::byte *end) {
+    std::apply([&in, end](auto &...members) { (ReadMember(members, in, end), ...); }, value);
+  }
+
+ private:
+  template <typename Member>
+  static std::size_t GetSize(const Member &member) {
+    return Serializer<Member>::Size(member);
+  }
+  template <typename Member>
+  static void WriteMember(const Member &member, std::byte *&out) {
+    Serializer<Member>::Write(member, out);
+  }
+  template <typename Member>
+  static void ReadMember(Member &member, const std::byte *&in, const std::byte *end) {
+    Serializer<Member>::Read(member, in, end);
+  }
+};
+
+}  // namespace detail
+
+template <typename Char, typename Traits, typename Allocator>
+struct Serializer<std::basic_string<Char, Traits, Allocator>>
+    : detail::SequenceSerializer<std::basic_string<Char, Traits, Allocator>> {};
+
+template <typename T, typename Allocator>
+struct Serializer<std::vector<T, Allocator>> : detail::SequenceSerializer<std::vector<T, Allocator>> {};
+
+template <typename T, std::size_t N>
+  requires(!std::is_trivially_copyable_v<std::array<T, N>>)
+struct Serializer<std::array<T, N>> : detail::ProductSerializer<std::array<T, N>> {};
+
+template <typename First, typename Second>
+  requires(!std::is_trivially_copyable_v<std::pair<First, Second>>)
+struct Serializer<std::pair<First, Second>> : detail::ProductSerializer<std::pair<First, Second>> {};
+
+template <typename... Ts>
+  requires(!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+struct Serializer<std::tuple<Ts...>> : detail::ProductSerializer<std::tuple<Ts...>> {};
+
+/// The active index is stored in front of the alternative; alternatives must be default constructible.
+template <typename... Ts>
+  requires(!std::is_trivially_copyable_v<std::variant<Ts...>>)
+struct Serializer<std::variant<Ts...>> {
+  using Variant = std::variant<Ts...>;
+
+  static std::size_t Size(const Variant &value) {
+    return sizeof(std::uint64_t) + std::visit([](const auto &alternative) { return GetSize(alternative); }, value);
+  }
+  static void Write(const Variant &value, std::byte *&out) {
+    if (value.valueless_by_exception()) {
+      throw std::invalid_argument("Cannot serialize a valueless std::variant");
+    }
+    detail::WriteLength(value.index(), out);
+    std::visit([&out](const auto &alternative) { WriteAlternative(alternative, out); }, value);
+  }
+  static void Read(Variant &value, const std::byte *&in, const std::byte *end) {
+    const std::size_t index = detail::ReadLength(in, end);
+    if (index >= sizeof...(Ts)) {
+      throw std::invalid_argument("Serialized std::variant index is out of range");
+    }
+    ReadAlternative(value, index, in, end, std::index_sequence_for<Ts...>{});
+  }
+
+ private:
+  template <typename Alternative>
+  static std::size_t GetSize(const Alternative &alternative) {
+    return Serializer<Alternative>::Size(alternative);
+  }
+  template <typename Alternative>
+  static void WriteAlternative(const Alternative &alternative, std::byte *&out) {
+    Serializer<Alternative>::Write(alternative, out);
+  }
+  template <std::size_t I>
+  static bool ReadAlternativeIf(Variant &value, std::size_t index, const std::byte *&in, const std::byte *end) {
+    if (index != I) {
+      return false;
+    }
+    Serializer<std::variant_alternative_t<I, Variant>>::Read(value.template emplace<I>(), in, end);
+    return true;
+  }
+  template <std::size_t... I>
+  static void ReadAlternative(Variant &value, std::size_t index, const std::byte *&in, const std::byte *end,
+                              std::index_sequence<I...>) {
+    (ReadAlternativeIf<I>(value, index, in, end) || ...);
+  }
+};
+
+/// @brief Returns the number of bytes Pack() produces for @p value.
+template <typename T>
+std::size_t GetPackedSize(const T &value) {
+  return Serializer<T>::Size(value);
+}
+
+/// @brief Packs @p value into one contiguous buffer of exactly GetPackedSize() bytes.
+template <typename T>
+std::vector<std::byte> Pack(const T &value) {
+  std::vector<std::byte> bytes(GetPackedSize(value));
+  std::byte *out = bytes.data();
+  Serializer<T>::Write(value, out);
+  return bytes;
+}
+
+/// @brief Restores @p value from a buffer produced by Pack() for the same type.
+/// @throws std::invalid_argument if the buffer does not hold exactly one value. Nothing is read past the end of
+/// @p bytes.
+template <typename T>
+void Unpack(std::span<const std::byte> bytes, T &value) {
+  const std::byte *in = bytes.data();
+  const std::byte *end = bytes.data() + bytes.size();
+  Serializer<T>::Read(value, in, end);
+  if (in != end) {
+    throw std::invalid_argument("Packed buffer does not match the size of the unpacked value");
+  }
+}
+
+namespace detail {
+
+void BroadcastBytes(std::vector<std::byte> &bytes, int root, MPI_Comm comm);
+void ScatterBytes(const std::vector<std::byte> &packed, const std::vector<std::uint64_t> &sizes,
+                  std::vector<std::byte> &local, int root, MPI_Comm comm);
+
+}  // namespace detail
+
+/// @brief Broadcasts @p value of @p root to every rank of @p comm.
+/// @details Trivially copyable values go in one MPI_Bcast; everything else is packed on @p root and sent as one size
+/// and one byte buffer, however many strings or rows the value holds.
+template <typename T>
+void Broadcast(T &value, int root, MPI_Comm comm) {
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    MPI_Bcast(&value, static_cast<int>(sizeof(T)), MPI_BYTE, root, comm);
+  } else {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+    std::vector<std::byte> bytes;
+    if (rank == root) {
+      bytes = Pack(value);
+    }
+    detail::BroadcastBytes(bytes, root, comm);
+    if (rank != root) {
+      Unpack(std::span<const std::byte>(bytes), value);
+    }
+  }
+}
+
+/// @brief Sends @p parts[i] of @p root to rank i of @p comm and returns the part of the calling rank.
+/// @details All parts are packed into one buffer on @p root and distributed with a single MPI_Scatterv. @p parts is
+/// only read on @p root.
+/// @throws std::invalid_argument on every rank if @p parts of @p root does not hold one part per rank.
+template <typename T>
+T Scatter(std::span<const T> parts, int root, MPI_Comm comm) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  std::vector<std::byte> packed;
+  std::vector<std::uint64_t> sizes;
+  // The count is checked on root but agreed on by all ranks, so a bad call throws everywhere instead of leaving the
+  // other ranks blocked in the scatter
+  int parts_match = (rank != root || parts.size() == static_cast<std::size_t>(size)) ? 1 : 0;
+  MPI_Bcast(&parts_match, 1, MPI_INT, root, comm);
+  if (parts_match == 0) {
+    throw std::invalid_argument("Scatter needs one part per rank");
+  }
+  if (rank == root) {
+    std::size_t total = 0;
+    for (const auto &part : parts) {
+      sizes.push_back(GetPackedSize(part));
+      total += sizes.back();
+    }
+    packed.resize(total);
+    std::byte *out = packed.data();
+    for (const auto &part : parts) {
+      Serializer<T>::Write(part, out);
+    }
+  }
+  std::vector<std::byte> local;
+  detail::ScatterBytes(packed, sizes, local, root, comm);
+  T value{};
+  Unpack(std::span<const std::byte>(local), value);
+  return value;
+}
+
+}  // namespace ppc::comm
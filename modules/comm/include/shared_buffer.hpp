@@ -0,0 +1,142 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "comm/include/collectives.hpp"
+
+namespace ppc::comm {
+
+/// @brief Node-local shared memory window holding one copy of a buffer per node.
+/// @details The ranks of a communicator are grouped by node with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED). The
+/// lowest rank of every node (its leader) allocates the memory with MPI_Win_allocate_shared, the other ranks of the
+/// node map the same pages. The node and leader communicators are split once per communicator and cached on it as an
+/// MPI attribute, so later windows on the same communicator only allocate. Construction is collective over the
+/// communicator, destruction over the ranks of each node. Allocate windows outside the measured stages, e.g. in
+/// PreProcessingImpl(), and keep them for the whole pipeline.
+class SharedWindow {
+ public:
+  SharedWindow() = default;
+  SharedWindow(std::size_t bytes, MPI_Comm comm);
+  ~SharedWindow();
+
+  SharedWindow(const SharedWindow &) = delete;
+  SharedWindow &operator=(const SharedWindow &) = delete;
+  SharedWindow(SharedWindow &&other) noexcept;
+  SharedWindow &operator=(SharedWindow &&other) noexcept;
+
+  /// @brief Returns the node copy; every rank of a node gets the same memory.
+  [[nodiscard]] std::byte *GetData() const {
+    return data_;
+  }
+  [[nodiscard]] std::size_t GetSize() const {
+    return size_;
+  }
+  [[nodiscard]] bool IsNodeLeader() const {
+    return leader_comm_ != MPI_COMM_NULL;
+  }
+  /// @brief Returns the communicator of the ranks sharing this node copy; owned by the construction communicator.
+  [[nodiscard]] MPI_Comm GetNodeComm() const {
+    return node_comm_;
+  }
+
+  /// @brief Makes the writes of every rank of a node visible to the whole node. Collective over the node.
+  void Sync() const;
+  /// @brief Copies the node copy of @p root to all other nodes and syncs every node.
+  /// @details Only the node leaders take part in the inter-node broadcast, so the data crosses the network once per
+  /// node instead of once per rank. @p root is a rank of the construction communicator and must have written its
+  /// node copy before the call.
+  void Publish(int root) const;
+
+ private:
+  void Release();
+
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+  MPI_Comm leader_comm_ = MPI_COMM_NULL;
+  MPI_Win win_ = MPI_WIN_NULL;
+  std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+  /// Rank in the leader communicator of the node leader of every rank of the construction communicator
+  const std::vector<int> *leader_of_rank_ = nullptr;
+};
+
+/// @brief Read-mostly array of @p T stored once per node in a SharedWindow.
+/// @details Replaces broadcasting a whole input to every rank: on a node with many ranks only one copy is kept and
+/// every rank reads it through GetSpan().
+template <typename T>
+class SharedBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "Shared buffers must hold trivially copyable elements");
+
+ public:
+  SharedBuffer() = default;
+  /// @brief Allocates @p count elements per node. Collective over @p comm.
+  SharedBuffer(std::size_t count, MPI_Comm comm) : window_(count * sizeof(T), comm), count_(count), comm_(comm) {}
+
+  /// @brief Allocates @p count elements of @p root per node; @p count is only read on @p root.
+  static SharedBuffer AllocateFromRoot(std::size_t count, int root, MPI_Comm comm) {
+    auto root_count = static_cast<std::uint64_t>(count);
+    MPI_Bcast(&root_count, 1, GetMpiType<std::uint64_t>(), root, comm);
+    return {static_cast<std::size_t>(root_count), comm};
+  }
+
+  /// @brief Places the @p data of @p root in every node copy; @p data is only read on @p root.
+  static SharedBuffer FromRoot(std::span<const T> data, int root, MPI_Comm comm) {
+    auto buffer = AllocateFromRoot(data.size(), root, comm);
+    buffer.Assign(data, root);
+    return buffer;
+  }
+
+  /// @brief Copies the @p data of @p root into every node copy; @p data is only read on @p root.
+  /// @details Reuses the allocated window, so a buffer created once in PreProcessingImpl() can be refilled on every
+  /// run. @p data must hold GetCount() elements on @p root.
+  void Assign(std::span<const T> data, int root) {
+    int rank = 0;
+    MPI_Comm_rank(GetComm(), &rank);
+    if (rank == root) {
+      std::ranges::copy(data.first(std::min(data.size(), count_)), GetMutableSpan().begin());
+    }
+    Publish(root);
+  }
+
+  /// @brief Returns the node copy. Valid until the buffer is destroyed or reassigned.
+  [[nodiscard]] std::span<const T> GetSpan() const {
+    return {reinterpret_cast<const T *>(window_.GetData()), count_};
+  }
+  /// @brief Returns the node copy for writing; call Sync() or Publish() before other ranks read it.
+  [[nodiscard]] std::span<T> GetMutableSpan() {
+    return {reinterpret_cast<T *>(window_.GetData()), count_};
+  }
+  [[nodiscard]] std::size_t GetCount() const {
+    return count_;
+  }
+  [[nodiscard]] bool IsNodeLeader() const {
+    return window_.IsNodeLeader();
+  }
+  /// @brief Returns the communicator the buffer was allocated on.
+  [[nodiscard]] MPI_Comm GetComm() const {
+    return comm_;
+  }
+
+  /// @copydoc SharedWindow::Sync
+  void Sync() const {
+    window_.Sync();
+  }
+  /// @copydoc SharedWindow::Publish
+  void Publish(int root) const {
+    window_.Publish(root);
+  }
+
+ private:
+  SharedWindow window_;
+  std::size_t count_ = 0;
+  MPI_Comm comm_ = MPI_COMM_NULL;
+};
+
+}  // namespace ppc::comm
@@ -0,0 +1,140 @@
+#include "comm/include/collectives.hpp"
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "comm/include/partition.hpp"
+
+namespace ppc::comm::detail {
+
+namespace {
+
+struct CommShape {
+  int rank = 0;
+  int size = 1;
+};
+
+CommShape CheckPlan(const PartitionPlan &plan, MPI_Comm comm) {
+  CommShape shape;
+  MPI_Comm_rank(comm, &shape.rank);
+  MPI_Comm_size(comm, &shape.size);
+  if (plan.GetParts() != shape.size) {
+    throw std::invalid_argument("Partition plan has " + std::to_string(plan.GetParts()) + " parts for " +
+                                std::to_string(shape.size) + " ranks");
+  }
+#if MPI_VERSION < 4
+  if (!plan.FitsInt()) {
+    throw std::overflow_error("Partition plan of " + std::to_string(plan.GetTotal()) +
+                              " elements exceeds the int counts of MPI " + std::to_string(MPI_VERSION));
+  }
+#endif
+  return shape;
+}
+
+/// Rank-major staging buffer for plans whose parts own several segments; reused across calls
+std::byte *GetPackBuffer(const PartitionPlan &plan, std::size_t element_size) {
+  thread_local std::vector<std::byte> buffer;
+  const auto bytes = static_cast<std::size_t>(plan.GetTotal()) * element_size;
+  if (buffer.size() < bytes) {
+    buffer.resize(bytes);
+  }
+  return buffer.data();
+}
+
+void Pack(const void *global, std::byte *packed, std::size_t element_size, const PartitionPlan &plan) {
+  const auto *source = static_cast<const std::byte *>(global);
+  for (int part = 0; part < plan.GetParts(); part++) {
+    for (const auto &segment : plan.GetSegments(part)) {
+      std::memcpy(packed, source + (static_cast<std::size_t>(segment.offset) * element_size),
+                  static_cast<std::size_t>(segment.count) * element_size);
+      packed += static_cast<std::size_t>(segment.count) * element_size;
+    }
+  }
+}
+
+void Unpack(const std::byte *packed, void *global, std::size_t element_size, const PartitionPlan &plan) {
+  auto *target = static_cast<std::byte *>(global);
+  for (int part = 0; part < plan.GetParts(); part++) {
+    for (const auto &segment : plan.GetSegments(part)) {
+      std::memcpy(target + (static_cast<std::size_t>(segment.offset) * element_size), packed,
+                  static_cast<std::size_t>(segment.count) * element_size);
+      packed += static_cast<std::size_t>(segment.count) * element_size;
+    }
+  }
+}
+
+}  // namespace
+
+void Scatterv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+              int root, MPI_Comm comm) {
+  const auto shape = CheckPlan(plan, comm);
+  if (!plan.IsContiguous() && shape.rank == root) {
+    std::byte *packed = GetPackBuffer(plan, element_size);
+    Pack(send, packed, element_size, plan);
+    send = packed;
+  }
+#if MPI_VERSION >= 4
+  MPI_Scatterv_c(send, plan.GetLargeCounts().data(), plan.GetLargeDispls().data(), type, recv,
+                 plan.GetLargeCounts()[shape.rank], type, root, comm);
+#else
+  MPI_Scatterv(send, plan.GetIntCounts().data(), plan.GetIntDispls().data(), type, recv,
+               plan.GetIntCounts()[shape.rank], type, root, comm);
+#endif
+}
+
+void Gatherv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+             int root, MPI_Comm comm) {
+  const auto shape = CheckPlan(plan, comm);
+  const bool unpack = !plan.IsContiguous() && shape.rank == root;
+  void *target = unpack ? GetPackBuffer(plan, element_size) : recv;
+#if MPI_VERSION >= 4
+  MPI_Gatherv_c(send, plan.GetLargeCounts()[shape.rank], type, target, plan.GetLargeCounts().data(),
+                plan.GetLargeDispls().data(), type, root, comm);
+#else
+  MPI_Gatherv(send, plan.GetIntCounts()[shape.rank], type, target, plan.GetIntCounts().data(),
+              plan.GetIntDispls().data(), type, root, comm);
+#endif
+  if (unpack) {
+    Unpack(static_cast<const std::byte *>(target), recv, element_size, plan);
+  }
+}
+
+void Allgatherv(const void *send, void *recv, std::size_t element_size, MPI_Datatype type, const PartitionPlan &plan,
+                MPI_Comm comm) {
+  const auto shape = CheckPlan(plan, comm);
+  const bool unpack = !plan.IsContiguous();
+  void *target = unpack ? GetPackBuffer(plan, element_size) : recv;
+#if MPI_VERSION >= 4
+  MPI_Allgatherv_c(send, plan.GetLargeCounts()[shape.rank], type, target, plan.GetLargeCounts().data(),
+                   plan.GetLargeDispls().data(), type, comm);
+#else
+  MPI_Allgatherv(send, plan.GetIntCounts()[shape.rank], type, target, plan.GetIntCounts().data(),
+                 plan.GetIntDispls().data(), type, comm);
+#endif
+  if (unpack) {
+    Unpack(static_cast<const std::byte *>(target), recv, element_size, plan);
+  }
+}
+
+MPI_Request Iallgatherv(const void *send, void *recv, MPI_Datatype type, const PartitionPlan &plan, MPI_Comm comm) {
+  const auto shape = CheckPlan(plan, comm);
+  if (!plan.IsContiguous()) {
+    throw std::invalid_argument("Nonblocking Allgatherv needs a contiguous partition plan");
+  }
+  MPI_Request request = MPI_REQUEST_NULL;
+#if MPI_VERSION >= 4
+  MPI_Iallgatherv_c(send, plan.GetLargeCounts()[shape.rank], type, recv, plan.GetLargeCounts().data(),
+                    plan.GetLargeDispls().data(), type, comm, &request);
+#else
+  MPI_Iallgatherv(send, plan.GetIntCounts()[shape.rank], type, recv, plan.GetIntCounts().data(),
+                  plan.GetIntDispls().data(), type, comm, &request);
+#endif
+  return request;
+}
+
+}  // namespace ppc::comm::detail
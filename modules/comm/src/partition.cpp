@@ -0,0 +1,163 @@
+#include "comm/include/partition.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ppc::comm {
+
+namespace {
+
+void CheckShape(std::int64_t total, int parts, std::int64_t unit) {
+  if (total < 0 || parts < 1 || unit < 1) {
+    throw std::invalid_argument("Partition needs total >= 0, parts >= 1 and unit >= 1");
+  }
+}
+
+enum class PlanKind : std::uint8_t { kBlock, kBlockCyclic, kWeighted };
+
+using PlanKey = std::tuple<PlanKind, std::int64_t, int, std::int64_t, std::int64_t, std::vector<double>>;
+
+template <typename Factory>
+const PartitionPlan &GetCachedPlan(PlanKey key, Factory &&factory) {
+  static std::mutex mutex;
+  static std::map<PlanKey, std::unique_ptr<const PartitionPlan>> cache;
+  const std::scoped_lock lock(mutex);
+  auto it = cache.find(key);
+  if (it == cache.end()) {
+    it = cache.emplace(std::move(key), std::make_unique<const PartitionPlan>(std::forward<Factory>(factory)())).first;
+  }
+  return *it->second;
+}
+
+}  // namespace
+
+PartitionPlan::PartitionPlan(std::int64_t unit, bool contiguous, std::vector<std::vector<Segment>> unit_segments)
+    : unit_(unit), contiguous_(contiguous) {
+  const std::size_t parts = unit_segments.size();
+  counts_.resize(parts);
+  displs_.resize(parts);
+  segment_begin_.reserve(parts + 1);
+  std::int64_t packed_offset = 0;
+  for (std::size_t part = 0; part < parts; part++) {
+    segment_begin_.push_back(segments_.size());
+    std::int64_t count = 0;
+    for (const auto &segment : unit_segments[part]) {
+      segments_.push_back({.offset = segment.offset * unit, .count = segment.count * unit});
+      count += segment.count * unit;
+    }
+    counts_[part] = count;
+    displs_[part] = packed_offset;
+    packed_offset += count;
+  }
+  segment_begin_.push_back(segments_.size());
+  total_ = packed_offset;
+
+  fits_int_ = total_ <= INT_MAX;
+  if (fits_int_) {
+    int_counts_.assign(counts_.begin(), counts_.end());
+    int_displs_.assign(displs_.begin(), displs_.end());
+  }
+#if MPI_VERSION >= 4
+  large_counts_.assign(counts_.begin(), counts_.end());
+  large_displs_.assign(displs_.begin(), displs_.end());
+#endif
+}
+
+PartitionPlan PartitionPlan::Block(std::int64_t total, int parts, std::int64_t unit) {
+  CheckShape(total, parts, unit);
+  const std::int64_t base = total / parts;
+  const std::int64_t remainder = total % parts;
+  std::vector<std::vector<Segment>> segments(static_cast<std::size_t>(parts));
+  std::int64_t offset = 0;
+  for (int part = 0; part < parts; part++) {
+    const std::int64_t count = base + (part < remainder ? 1 : 0);
+    segments[static_cast<std::size_t>(part)].push_back({.offset = offset, .count = count});
+    offset += count;
+  }
+  return {unit, true, std::move(segments)};
+}
+
+PartitionPlan PartitionPlan::BlockCyclic(std::int64_t total, int parts, std::int64_t block_size, std::int64_t unit) {
+  CheckShape(total, parts, unit);
+  if (block_size < 1) {
+    throw std::invalid_argument("Block-cyclic partition needs block_size >= 1");
+  }
+  if (parts == 1 || total <= block_size) {
+    return Block(total, parts, unit);
+  }
+  std::vector<std::vector<Segment>> segments(static_cast<std::size_t>(parts));
+  std::int64_t block = 0;
+  for (std::int64_t offset = 0; offset < total; offset += block_size, block++) {
+    segments[static_cast<std::size_t>(block % parts)].push_back(
+        {.offset = offset, .count = std::min(block_size, total - offset)});
+  }
+  return {unit, false, std::move(segments)};
+}
+
+PartitionPlan PartitionPlan::Weighted(std::int64_t total, std::span<const double> weights, std::int64_t unit) {
+  CheckShape(total, static_cast<int>(weights.size()), unit);
+  const double weight_sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  if (std::ranges::any_of(weights, [](double weight) { return !(weight >= 0.0); }) || !(weight_sum > 0.0)) {
+    throw std::invalid_argument("Weighted partition needs non-negative weights with a positive sum");
+  }
+
+  const std::size_t parts = weights.size();
+  std::vector<std::int64_t> counts(parts);
+  std::vector<std::pair<double, std::size_t>> fractions(parts);
+  std::int64_t assigned = 0;
+  for (std::size_t part = 0; part < parts; part++) {
+    const double share = static_cast<double>(total) * weights[part] / weight_sum;
+    counts[part] = static_cast<std::int64_t>(std::floor(share));
+    fractions[part] = {share - static_cast<double>(counts[part]), part};
+    assigned += counts[part];
+  }
+  // Largest fractional shares first, lower parts first on ties
+  std::ranges::stable_sort(fractions, [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+  for (std::size_t i = 0; assigned < total; i = (i + 1) % parts, assigned++) {
+    counts[fractions[i].second]++;
+  }
+
+  std::vector<std::vector<Segment>> segments(parts);
+  std::int64_t offset = 0;
+  for (std::size_t part = 0; part < parts; part++) {
+    segments[part].push_back({.offset = offset, .count = counts[part]});
+    offset += counts[part];
+  }
+  return {unit, true, std::move(segments)};
+}
+
+std::span<const Segment> PartitionPlan::GetSegments(int part) const {
+  const auto index = static_cast<std::size_t>(part);
+  return std::span<const Segment>(segments_).subspan(segment_begin_[index],
+                                                    segment_begin_[index + 1] - segment_begin_[index]);
+}
+
+const PartitionPlan &GetBlockPlan(std::int64_t total, int parts, std::int64_t unit) {
+  return GetCachedPlan({PlanKind::kBlock, total, parts, 0, unit, {}},
+                       [&] { return PartitionPlan::Block(total, parts, unit); });
+}
+
+const PartitionPlan &GetBlockCyclicPlan(std::int64_t total, int parts, std::int64_t block_size, std::int64_t unit) {
+  return GetCachedPlan({PlanKind::kBlockCyclic, total, parts, block_size, unit, {}},
+                       [&] { return PartitionPlan::BlockCyclic(total, parts, block_size, unit); });
+}
+
+const PartitionPlan &GetWeightedPlan(std::int64_t total, std::span<const double> weights, std::int64_t unit) {
+  return GetCachedPlan(
+      {PlanKind::kWeighted, total, static_cast<int>(weights.size()), 0, unit, {weights.begin(), weights.end()}},
+      [&] { return PartitionPlan::Weighted(total, weights, unit); });
+}
+
+}  // namespace ppc::comm
@@ -0,0 +1,65 @@
+#include "comm/include/serializer.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::comm::detail {
+
+void BroadcastBytes(std::vector<std::byte> &bytes, int root, MPI_Comm comm) {
+  auto size = static_cast<std::uint64_t>(bytes.size());
+  MPI_Bcast(&size, 1, MPI_UINT64_T, root, comm);
+  bytes.resize(static_cast<std::size_t>(size));
+  // MPI-3 counts are int, so buffers above INT_MAX bytes go in slices
+  for (std::size_t offset = 0; offset < bytes.size(); offset += INT_MAX) {
+    const auto count = static_cast<int>(std::min<std::size_t>(INT_MAX, bytes.size() - offset));
+    MPI_Bcast(bytes.data() + offset, count, MPI_BYTE, root, comm);
+  }
+}
+
+void ScatterBytes(const std::vector<std::byte> &packed, const std::vector<std::uint64_t> &sizes,
+                  std::vector<std::byte> &local, int root, MPI_Comm comm) {
+  int rank = 0;
+  MPI_Comm_rank(comm, &rank);
+  std::uint64_t local_size = 0;
+  MPI_Scatter(sizes.data(), 1, MPI_UINT64_T, &local_size, 1, MPI_UINT64_T, root, comm);
+  local.resize(static_cast<std::size_t>(local_size));
+
+#if MPI_VERSION >= 4
+  std::vector<MPI_Count> counts;
+  std::vector<MPI_Aint> displs;
+#else
+  std::vector<int> counts;
+  std::vector<int> displs;
+  // Checked on every rank so that an oversized scatter fails everywhere instead of leaving the others waiting
+  std::uint64_t total = packed.size();
+  MPI_Bcast(&total, 1, MPI_UINT64_T, root, comm);
+  if (total > INT_MAX) {
+    throw std::overflow_error("Packed scatter of " + std::to_string(total) + " bytes exceeds the int counts of MPI " +
+                              std::to_string(MPI_VERSION));
+  }
+#endif
+  if (rank == root) {
+    std::uint64_t offset = 0;
+    for (const std::uint64_t size : sizes) {
+      counts.push_back(static_cast<decltype(counts)::value_type>(size));
+      displs.push_back(static_cast<decltype(displs)::value_type>(offset));
+      offset += size;
+    }
+  }
+#if MPI_VERSION >= 4
+  MPI_Scatterv_c(packed.data(), counts.data(), displs.data(), MPI_BYTE, local.data(),
+                 static_cast<MPI_Count>(local.size()), MPI_BYTE, root, comm);
+#else
+  MPI_Scatterv(packed.data(), counts.data(), displs.data(), MPI_BYTE, local.data(), static_cast<int>(local.size()),
+               MPI_BYTE, root, comm);
+#endif
+}
+
+}  // namespace ppc::comm::detail
@@ -0,0 +1,167 @@
+#include "comm/include/shared_buffer.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ppc::comm {
+
+namespace {
+
+/// Node grouping of one communicator, cached on it as an attribute
+struct NodeTopology {
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm leader_comm = MPI_COMM_NULL;
+  std::vector<int> leader_of_rank;
+};
+
+int DeleteNodeTopology(MPI_Comm /*comm*/, int /*keyval*/, void *attribute, void * /*extra_state*/) {
+  const std::unique_ptr<NodeTopology> topology(static_cast<NodeTopology *>(attribute));
+  if (topology->leader_comm != MPI_COMM_NULL) {
+    MPI_Comm_free(&topology->leader_comm);
+  }
+  MPI_Comm_free(&topology->node_comm);
+  return MPI_SUCCESS;
+}
+
+int node_topology_keyval = MPI_KEYVAL_INVALID;
+
+// MPI_Finalize deletes the attributes of MPI_COMM_SELF first, while MPI is still fully usable. The grouping of
+// MPI_COMM_WORLD is dropped from there, because the standard does not say whether world attributes are ever deleted.
+int DeleteWorldNodeTopology(MPI_Comm /*comm*/, int /*keyval*/, void * /*attribute*/, void * /*extra_state*/) {
+  void *attribute = nullptr;
+  int found = 0;
+  MPI_Comm_get_attr(MPI_COMM_WORLD, node_topology_keyval, &attribute, &found);
+  if (found != 0) {
+    MPI_Comm_delete_attr(MPI_COMM_WORLD, node_topology_keyval);
+  }
+  return MPI_SUCCESS;
+}
+
+int GetNodeTopologyKeyval() {
+  static const int kKeyval = [] {
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, DeleteNodeTopology, &node_topology_keyval, nullptr);
+    int finalize_keyval = MPI_KEYVAL_INVALID;
+    MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, DeleteWorldNodeTopology, &finalize_keyval, nullptr);
+    MPI_Comm_set_attr(MPI_COMM_SELF, finalize_keyval, nullptr);
+    return node_topology_keyval;
+  }();
+  return kKeyval;
+}
+
+/// Returns the grouping of @p comm, splitting it on first use. Collective over @p comm on first use.
+const NodeTopology &GetNodeTopology(MPI_Comm comm) {
+  const int keyval = GetNodeTopologyKeyval();
+  void *attribute = nullptr;
+  int found = 0;
+  MPI_Comm_get_attr(comm, keyval, &attribute, &found);
+  if (found != 0) {
+    return *static_cast<const NodeTopology *>(attribute);
+  }
+
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  auto topology = std::make_unique<NodeTopology>();
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &topology->node_comm);
+  int node_rank = 0;
+  MPI_Comm_rank(topology->node_comm, &node_rank);
+  MPI_Comm_split(comm, node_rank == 0 ? 0 : MPI_UNDEFINED, rank, &topology->leader_comm);
+
+  int leader_rank = 0;
+  if (topology->leader_comm != MPI_COMM_NULL) {
+    MPI_Comm_rank(topology->leader_comm, &leader_rank);
+  }
+  MPI_Bcast(&leader_rank, 1, MPI_INT, 0, topology->node_comm);
+  topology->leader_of_rank.resize(static_cast<std::size_t>(size));
+  MPI_Allgather(&leader_rank, 1, MPI_INT, topology->leader_of_rank.data(), 1, MPI_INT, comm);
+
+  MPI_Comm_set_attr(comm, keyval, topology.get());
+  return *topology.release();
+}
+
+}  // namespace
+
+SharedWindow::SharedWindow(std::size_t bytes, MPI_Comm comm) : size_(bytes) {
+  const NodeTopology &topology = GetNodeTopology(comm);
+  node_comm_ = topology.node_comm;
+  leader_comm_ = topology.leader_comm;
+  leader_of_rank_ = &topology.leader_of_rank;
+
+  int node_rank = 0;
+  MPI_Comm_rank(node_comm_, &node_rank);
+  void *base = nullptr;
+  MPI_Win_allocate_shared(node_rank == 0 ? static_cast<MPI_Aint>(bytes) : 0, 1, MPI_INFO_NULL, node_comm_, &base,
+                          &win_);
+  MPI_Aint leader_bytes = 0;
+  int disp_unit = 1;
+  MPI_Win_shared_query(win_, 0, &leader_bytes, &disp_unit, &base);
+  data_ = static_cast<std::byte *>(base);
+  // One passive epoch for the lifetime of the window, as required by MPI_Win_sync in Sync()
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+}
+
+SharedWindow::~SharedWindow() {
+  Release();
+}
+
+SharedWindow::SharedWindow(SharedWindow &&other) noexcept
+    : node_comm_(std::exchange(other.node_comm_, MPI_COMM_NULL)),
+      leader_comm_(std::exchange(other.leader_comm_, MPI_COMM_NULL)),
+      win_(std::exchange(other.win_, MPI_WIN_NULL)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      leader_of_rank_(std::exchange(other.leader_of_rank_, nullptr)) {}
+
+SharedWindow &SharedWindow::operator=(SharedWindow &&other) noexcept {
+  if (this != &other) {
+    Release();
+    node_comm_ = std::exchange(other.node_comm_, MPI_COMM_NULL);
+    leader_comm_ = std::exchange(other.leader_comm_, MPI_COMM_NULL);
+    win_ = std::exchange(other.win_, MPI_WIN_NULL);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    leader_of_rank_ = std::exchange(other.leader_of_rank_, nullptr);
+  }
+  return *this;
+}
+
+void SharedWindow::Release() {
+  // The communicators belong to the cached grouping of the construction communicator
+  if (win_ != MPI_WIN_NULL) {
+    MPI_Win_unlock_all(win_);
+    MPI_Win_free(&win_);
+  }
+  node_comm_ = MPI_COMM_NULL;
+  leader_comm_ = MPI_COMM_NULL;
+  leader_of_rank_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+void SharedWindow::Sync() const {
+  MPI_Win_sync(win_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(win_);
+}
+
+void SharedWindow::Publish(int root) const {
+  Sync();
+  if (leader_comm_ != MPI_COMM_NULL) {
+    const int root_leader = (*leader_of_rank_)[static_cast<std::size_t>(root)];
+    // MPI-3 counts are int, so copies above INT_MAX bytes go in slices
+    for (std::size_t offset = 0; offset < size_; offset += INT_MAX) {
+      const auto count = static_cast<int>(std::min<std::size_t>(INT_MAX, size_ - offset));
+      MPI_Bcast(data_ + offset, count, MPI_BYTE, root_leader, leader_comm_);
+    }
+  }
+  Sync();
+}
+
+}  // namespace ppc::comm
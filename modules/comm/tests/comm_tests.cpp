@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "comm/include/collectives.hpp"
+#include "comm/include/partition.hpp"
+#include "comm/include/serializer.hpp"
+#include "comm/include/shared_buffer.hpp"
+
+namespace {
+
+std::vector<int64_t> GetCounts(const ppc::comm::PartitionPlan &plan) {
+  std::vector<int64_t> counts;
+  for (int part = 0; part < plan.GetParts(); part++) {
+    counts.push_back(plan.GetCount(part));
+  }
+  return counts;
+}
+
+}  // namespace
+
+TEST(PartitionTest, BlockGivesRemainderToFirstParts) {
+  const auto plan = ppc::comm::PartitionPlan::Block(10, 4, 3);
+  EXPECT_TRUE(plan.IsContiguous());
+  EXPECT_EQ(plan.GetTotal(), 30);
+  EXPECT_EQ(GetCounts(plan), (std::vector<int64_t>{9, 9, 6, 6}));
+  EXPECT_EQ(plan.GetIntDispls(), (std::vector<int>{0, 9, 18, 24}));
+  EXPECT_EQ(plan.GetUnitCount(2), 2);
+  EXPECT_EQ(plan.GetUnitOffset(2), 6);
+}
+
+TEST(PartitionTest, BlockHandlesMorePartsThanUnits) {
+  const auto plan = ppc::comm::PartitionPlan::Block(2, 4);
+  EXPECT_EQ(GetCounts(plan), (std::vector<int64_t>{1, 1, 0, 0}));
+  EXPECT_EQ(plan.GetDispl(3), 2);
+}
+
+TEST(PartitionTest, BlockCyclicDealsBlocksRoundRobin) {
+  const auto plan = ppc::comm::PartitionPlan::BlockCyclic(10, 2, 3);
+  EXPECT_FALSE(plan.IsContiguous());
+  EXPECT_EQ(GetCounts(plan), (std::vector<int64_t>{6, 4}));
+  const auto segments = plan.GetSegments(0);
+  ASSERT_EQ(segments.size(), 2U);
+  EXPECT_EQ(segments[0].offset, 0);
+  EXPECT_EQ(segments[1].offset, 6);
+  EXPECT_EQ(plan.GetSegments(1).back().count, 1);
+  EXPECT_EQ(plan.GetDispl(1), 6);
+}
+
+TEST(PartitionTest, WeightedRoundsByLargestRemainder) {
+  const std::array<double, 3> weights = {1.0, 1.0, 2.0};
+  const auto plan = ppc::comm::PartitionPlan::Weighted(7, weights);
+  EXPECT_EQ(GetCounts(plan), (std::vector<int64_t>{2, 2, 3}));
+  const auto counts = GetCounts(plan);
+  EXPECT_EQ(std::accumulate(counts.begin(), counts.end(), int64_t{0}), 7);
+}
+
+TEST(PartitionTest, RejectsInvalidShapes) {
+  const std::array<double, 2> zero_weights = {0.0, 0.0};
+  EXPECT_THROW(ppc::comm::PartitionPlan::Block(10, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::comm::PartitionPlan::BlockCyclic(10, 2, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::comm::PartitionPlan::Weighted(10, zero_weights), std::invalid_argument);
+}
+
+TEST(PartitionTest, LargePlansDoNotFitInt) {
+  const auto plan = ppc::comm::PartitionPlan::Block(int64_t{1} << 31, 2);
+  EXPECT_FALSE(plan.FitsInt());
+  EXPECT_EQ(plan.GetCount(1), int64_t{1} << 30);
+}
+
+TEST(PartitionTest, CachedPlansAreReused) {
+  const auto &plan = ppc::comm::GetBlockPlan(100, 3, 2);
+  EXPECT_EQ(&plan, &ppc::comm::GetBlockPlan(100, 3, 2));
+  EXPECT_NE(&plan, &ppc::comm::GetBlockPlan(100, 3));
+  EXPECT_EQ(plan.GetCount(0), 68);
+}
+
+TEST(CollectivesTest, BlockCyclicRoundTripsThroughScatterAndGather) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const auto &plan = ppc::comm::GetBlockCyclicPlan(17, size, 2, 3);
+  std::vector<double> global(static_cast<std::size_t>(plan.GetTotal()));
+  std::iota(global.begin(), global.end(), 0.0);
+  std::vector<double> local(static_cast<std::size_t>(plan.GetCount(rank)));
+  ppc::comm::Scatterv(global.data(), local.data(), plan, 0, MPI_COMM_WORLD);
+
+  auto local_it = local.begin();
+  for (const auto &segment : plan.GetSegments(rank)) {
+    for (int64_t i = 0; i < segment.count; i++, ++local_it) {
+      EXPECT_EQ(*local_it, static_cast<double>(segment.offset + i));
+    }
+  }
+
+  std::vector<double> gathered(global.size());
+  ppc::comm::Allgatherv(local.data(), gathered.data(), plan, MPI_COMM_WORLD);
+  EXPECT_EQ(gathered, global);
+  EXPECT_THROW(ppc::comm::Gatherv(local.data(), gathered.data(), ppc::comm::GetBlockPlan(17, size + 1), 0,
+                                  MPI_COMM_WORLD),
+               std::invalid_argument);
+
+  const auto &block_plan = ppc::comm::GetBlockPlan(11, size);
+  std::vector<int> block(static_cast<std::size_t>(block_plan.GetCount(rank)), rank);
+  std::vector<int> owners(11, -1);
+  MPI_Request request = ppc::comm::Iallgatherv(block.data(), owners.data(), block_plan, MPI_COMM_WORLD);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+  for (int part = 0; part < size; part++) {
+    for (int64_t i = 0; i < block_plan.GetCount(part); i++) {
+      EXPECT_EQ(owners[static_cast<std::size_t>(block_plan.GetDispl(part) + i)], part);
+    }
+  }
+  if (!plan.IsContiguous()) {
+    EXPECT_THROW(ppc::comm::Iallgatherv(local.data(), gathered.data(), plan, MPI_COMM_WORLD), std::invalid_argument);
+  }
+}
+
+TEST(SharedBufferTest, PublishesRootDataToEveryNodeCopy) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  const int root = size - 1;
+
+  std::vector<double> data;
+  if (rank == root) {
+    data.resize(1000);
+    std::iota(data.begin(), data.end(), 0.5);
+  }
+  auto buffer = ppc::comm::SharedBuffer<double>::FromRoot(data, root, MPI_COMM_WORLD);
+  ASSERT_EQ(buffer.GetCount(), 1000U);
+  for (std::size_t i = 0; i < buffer.GetCount(); i++) {
+    ASSERT_EQ(buffer.GetSpan()[i], static_cast<double>(i) + 0.5);
+  }
+
+  int leaders = buffer.IsNodeLeader() ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &leaders, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  EXPECT_GE(leaders, 1);
+  EXPECT_LE(leaders, size);
+
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  int node_size = 0;
+  MPI_Comm_size(node_comm, &node_size);
+  MPI_Comm_free(&node_comm);
+
+  ppc::comm::SharedBuffer<int> marks(static_cast<std::size_t>(size), MPI_COMM_WORLD);
+  if (marks.IsNodeLeader()) {
+    std::ranges::fill(marks.GetMutableSpan(), 0);
+  }
+  marks.Sync();
+  marks.GetMutableSpan()[static_cast<std::size_t>(rank)] = 1;
+  marks.Sync();
+  // Every rank sees the writes of exactly the ranks on its own node
+  EXPECT_EQ(std::accumulate(marks.GetSpan().begin(), marks.GetSpan().end(), 0), node_size);
+}
+
+TEST(SharedBufferTest, ReusesNodeGroupingAndWindow) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm comm = MPI_COMM_NULL;
+  MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+  {
+    // The node split is done once per communicator, not once per window
+    const ppc::comm::SharedWindow first(16, comm);
+    const ppc::comm::SharedWindow second(8, comm);
+    EXPECT_EQ(first.GetNodeComm(), second.GetNodeComm());
+
+    auto buffer = ppc::comm::SharedBuffer<int>::AllocateFromRoot(rank == 0 ? 3 : 0, 0, comm);
+    EXPECT_EQ(buffer.GetComm(), comm);
+    ASSERT_EQ(buffer.GetCount(), 3U);
+
+    for (int round = 0; round < 2; round++) {
+      std::vector<int> data;
+      if (rank == 0) {
+        data = {round, round + 1, round + 2};
+      }
+      buffer.Assign(data, 0);
+      EXPECT_EQ(std::vector<int>(buffer.GetSpan().begin(), buffer.GetSpan().end()),
+                (std::vector<int>{round, round + 1, round + 2}));
+    }
+  }
+  // Freeing the communicator releases its cached node grouping
+  MPI_Comm_free(&comm);
+}
+
+TEST(SerializerTest, RoundTripsNestedStandardTypes) {
+  using Value = std::tuple<std::string, std::vector<std::vector<int>>, std::pair<double, std::vector<std::string>>,
+                           std::variant<std::vector<float>, std::string>, std::vector<bool>>;
+  const Value value{"abc", {{1, 2, 3}, {}, {4}}, {2.5, {"x", "", "yz"}}, std::string("alt"), {true, false, true}};
+
+  const auto bytes = ppc::comm::Pack(value);
+  EXPECT_EQ(bytes.size(), ppc::comm::GetPackedSize(value));
+  Value restored;
+  ppc::comm::Unpack(std::span<const std::byte>(bytes), restored);
+  EXPECT_EQ(restored, value);
+
+  // A flat matrix row is one length plus one block of elements
+  EXPECT_EQ(ppc::comm::GetPackedSize(std::vector<int>(10)), sizeof(std::uint64_t) + (10 * sizeof(int)));
+  std::vector<int> wrong_type;
+  EXPECT_THROW(ppc::comm::Unpack(std::span<const std::byte>(ppc::comm::Pack(std::vector<char>(3))), wrong_type),
+               std::invalid_argument);
+}
+
+TEST(SerializerTest, RejectsTruncatedBuffersBeforeReading) {
+  const std::vector<std::string> value{"alpha", "beta"};
+  const auto bytes = ppc::comm::Pack(value);
+  for (std::size_t size = 0; size < bytes.size(); size++) {
+    std::vector<std::string> restored;
+    EXPECT_THROW(ppc::comm::Unpack(std::span<const std::byte>(bytes.data(), size), restored), std::invalid_argument);
+  }
+
+  // A corrupt length is rejected before it is used to size the container
+  auto huge_length = ppc::comm::Pack(std::vector<int>{});
+  const std::uint64_t length = UINT64_MAX / 2;
+  std::memcpy(huge_length.data(), &length, sizeof(length));
+  std::vector<int> restored;
+  EXPECT_THROW(ppc::comm::Unpack(std::span<const std::byte>(huge_length), restored), std::invalid_argument);
+}
+
+TEST(SerializerTest, BroadcastsAndScattersInOneMessage) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::tuple<std::vector<std::string>, std::variant<int, std::vector<double>>> value;
+  if (rank == 0) {
+    value = {{"alpha", "beta"}, std::vector<double>{1.0, 2.0}};
+  }
+  ppc::comm::Broadcast(value, 0, MPI_COMM_WORLD);
+  EXPECT_EQ(std::get<0>(value), (std::vector<std::string>{"alpha", "beta"}));
+  EXPECT_EQ(std::get<1>(value), (std::variant<int, std::vector<double>>{std::vector<double>{1.0, 2.0}}));
+
+  std::vector<std::vector<std::vector<int>>> parts;
+  if (rank == 0) {
+    for (int part = 0; part < size; part++) {
+      parts.emplace_back(static_cast<std::size_t>(part), std::vector<int>{part, part + 1});
+    }
+  }
+  const auto local = ppc::comm::Scatter<std::vector<std::vector<int>>>(parts, 0, MPI_COMM_WORLD);
+  EXPECT_EQ(local, std::vector<std::vector<int>>(static_cast<std::size_t>(rank), std::vector<int>{rank, rank + 1}));
+}
+
+TEST(SerializerTest, ScatterWithWrongPartCountThrowsOnEveryRank) {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    GTEST_SKIP() << "MPI is not initialized";
+  }
+  // Root passes no parts at all; without the agreed check the other ranks would block in the scatter
+  const std::vector<int> parts;
+  EXPECT_THROW(ppc::comm::Scatter<int>(parts, 0, MPI_COMM_WORLD), std::invalid_argument);
+}
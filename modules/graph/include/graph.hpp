@@ -0,0 +1,244 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "task/include/async_executor.hpp"
+#include "task/include/task.hpp"
+
+namespace ppc::graph {
+
+/// @brief Input type of a task class, deduced from Task::GetInput().
+template <typename TaskType>
+using InputOf = std::remove_reference_t<decltype(std::declval<TaskType &>().GetInput())>;
+
+/// @brief Output type of a task class, deduced from Task::GetOutput().
+template <typename TaskType>
+using OutputOf = std::remove_reference_t<decltype(std::declval<TaskType &>().GetOutput())>;
+
+/// @brief Typed handle of a graph node.
+/// @tparam OutType Output type of the node's task.
+template <typename OutType>
+struct NodeRef {
+  std::size_t id;
+};
+
+/// @brief Timing of one executed node.
+struct NodeTiming {
+  std::string name;
+  ppc::task::TypeOfTask type_of_task = ppc::task::TypeOfTask::kUnknown;
+  /// Start of the node relative to the start of the graph in seconds
+  double start_sec = 0.0;
+  /// End of the node relative to the start of the graph in seconds
+  double end_sec = 0.0;
+  ppc::task::StageTimings stage_timings;
+
+  [[nodiscard]] double Duration() const {
+    return end_sec - start_sec;
+  }
+};
+
+/// @brief Timings of one TaskGraph::Run() call.
+struct GraphResults {
+  /// Per-node timings indexed by node id
+  std::vector<NodeTiming> nodes;
+  /// Wall time of the whole graph in seconds
+  double total_sec = 0.0;
+  /// Sum of node durations along the longest dependency chain in seconds
+  double critical_path_sec = 0.0;
+  /// Node ids of the longest dependency chain, from the first node to the last
+  std::vector<std::size_t> critical_path;
+};
+
+/// @brief Directed acyclic graph of tasks whose inputs are built from the outputs of other tasks.
+/// @details Nodes can only depend on nodes that were added before them, so the graph is acyclic by construction.
+/// Independent nodes run concurrently on an AsyncExecutor. Outputs stay inside the producing task and are handed to
+/// the consumer's combine function by reference, so a consumer that is the only reader may move them instead of
+/// copying. MPI and ALL nodes run on the communicator selected with SetComm() when they were added. Nodes on one
+/// communicator are chained in the order they were added, so every rank runs them in the same order, while nodes on
+/// other communicators and thread-backend nodes still overlap with them. Unless MPI provides MPI_THREAD_MULTIPLE, MPI
+/// and ALL nodes run on the thread that called Run() instead of on the workers, so they never communicate from a
+/// second thread; they then run one after another. A graph runs once, because the inputs of its sources are moved
+/// into the tasks.
+class TaskGraph {
+ public:
+  TaskGraph() = default;
+  TaskGraph(const TaskGraph &) = delete;
+  TaskGraph &operator=(const TaskGraph &) = delete;
+  ~TaskGraph() = default;
+
+  /// @brief Selects the communicator of the MPI and ALL nodes added after this call; MPI_COMM_WORLD by default.
+  /// @details Nodes on a communicator other than MPI_COMM_WORLD must satisfy ppc::task::UsesTaskComm. The
+  /// communicator must outlive every Run() of the graph.
+  void SetComm(MPI_Comm comm) {
+    comm_ = comm;
+  }
+
+  /// @brief Adds a node without dependencies.
+  /// @param name Name used in the timings.
+  /// @param input Input moved into the task when the node starts.
+  template <typename TaskType>
+  NodeRef<OutputOf<TaskType>> AddSource(std::string name, InputOf<TaskType> input) {
+    auto make_input = [input = std::move(input)]() mutable { return std::move(input); };
+    return AddNode<TaskType>(std::move(name), std::move(make_input), {});
+  }
+
+  /// @brief Adds a node whose input is built from the outputs of other nodes.
+  /// @param name Name used in the timings.
+  /// @param combine Callable receiving `OutType &` of every dependency and returning the task input.
+  /// @param deps Nodes the new node depends on.
+  template <typename TaskType, typename Combine, typename... DepOut>
+    requires(sizeof...(DepOut) > 0)
+  NodeRef<OutputOf<TaskType>> Add(std::string name, Combine combine, NodeRef<DepOut>... deps) {
+    auto make_input = [this, combine = std::move(combine), deps...]() mutable -> InputOf<TaskType> {
+      return combine(Output(deps)...);
+    };
+    return AddNode<TaskType>(std::move(name), std::move(make_input), {deps.id...});
+  }
+
+  /// @brief Returns the output of an executed node.
+  /// @throws std::runtime_error If the node has not run yet.
+  template <typename OutType>
+  OutType &Output(NodeRef<OutType> ref) {
+    return static_cast<OutputNode<OutType> &>(*nodes_.at(ref.id)).Output();
+  }
+
+  /// @brief Returns the number of nodes.
+  [[nodiscard]] std::size_t Size() const {
+    return nodes_.size();
+  }
+
+  /// @brief Runs all nodes on the given executor and waits for them.
+  /// @throws std::runtime_error If the graph already ran.
+  /// @throws The first exception thrown by a node; nodes depending on it are not started.
+  GraphResults Run(ppc::task::AsyncExecutor &executor);
+
+  /// @brief Runs all nodes on a temporary executor.
+  /// @param num_workers Number of worker threads; 0 selects the hardware concurrency.
+  GraphResults Run(std::size_t num_workers = 0) {
+    ppc::task::AsyncExecutor executor(num_workers);
+    return Run(executor);
+  }
+
+ private:
+  class NodeBase {
+   public:
+    NodeBase(std::string name, ppc::task::TypeOfTask type_of_task, std::vector<std::size_t> deps)
+        : name_(std::move(name)), type_of_task_(type_of_task), deps_(std::move(deps)) {}
+    NodeBase(const NodeBase &) = delete;
+    NodeBase &operator=(const NodeBase &) = delete;
+    virtual ~NodeBase() = default;
+
+    /// @brief Builds the input, creates the task and runs its pipeline.
+    virtual void Execute() = 0;
+    [[nodiscard]] virtual ppc::task::StageTimings GetStageTimings() const = 0;
+
+    [[nodiscard]] const std::string &GetName() const {
+      return name_;
+    }
+    [[nodiscard]] ppc::task::TypeOfTask GetTypeOfTask() const {
+      return type_of_task_;
+    }
+    [[nodiscard]] const std::vector<std::size_t> &GetDeps() const {
+      return deps_;
+    }
+
+   private:
+    std::string name_;
+    ppc::task::TypeOfTask type_of_task_;
+    std::vector<std::size_t> deps_;
+  };
+
+  template <typename OutType>
+  class OutputNode : public NodeBase {
+   public:
+    using NodeBase::NodeBase;
+    virtual OutType &Output() = 0;
+  };
+
+  template <typename TaskType>
+  class TaskNode : public OutputNode<OutputOf<TaskType>> {
+   public:
+    TaskNode(std::string name, std::vector<std::size_t> deps, std::function<InputOf<TaskType>()> make_input,
+             MPI_Comm comm)
+        : OutputNode<OutputOf<TaskType>>(std::move(name), TaskType::GetStaticTypeOfTask(), std::move(deps)),
+          make_input_(std::move(make_input)),
+          comm_(comm) {}
+
+    void Execute() override {
+      task_ = std::make_shared<TaskType>(make_input_());
+      task_->SetComm(comm_);
+      if (!task_->RunPipeline()) {
+        throw std::runtime_error("Task graph node '" + this->GetName() + "' failed");
+      }
+    }
+
+    [[nodiscard]] ppc::task::StageTimings GetStageTimings() const override {
+      return task_ ? task_->GetStageTimings() : ppc::task::StageTimings{};
+    }
+
+    OutputOf<TaskType> &Output() override {
+      if (!task_) {
+        throw std::runtime_error("Task graph node '" + this->GetName() + "' has not run");
+      }
+      return task_->GetOutput();
+    }
+
+   private:
+    std::function<InputOf<TaskType>()> make_input_;
+    MPI_Comm comm_;
+    std::shared_ptr<TaskType> task_;
+  };
+
+  struct RunState;
+
+  template <typename TaskType, typename MakeInput>
+  NodeRef<OutputOf<TaskType>> AddNode(std::string name, MakeInput make_input, std::vector<std::size_t> deps) {
+    const std::size_t id = nodes_.size();
+    MPI_Comm comm = MPI_COMM_WORLD;
+    if (IsCommunicating(TaskType::GetStaticTypeOfTask())) {
+      if constexpr (ppc::task::UsesTaskComm<TaskType>) {
+        comm = comm_;
+      } else if (comm_ != MPI_COMM_WORLD) {
+        throw std::invalid_argument("Task graph node '" + name + "' does not use the task communicator");
+      }
+      auto last = std::ranges::find(last_communicating_nodes_, comm, &std::pair<MPI_Comm, std::size_t>::first);
+      if (last == last_communicating_nodes_.end()) {
+        last_communicating_nodes_.emplace_back(comm, id);
+      } else {
+        if (std::ranges::find(deps, last->second) == deps.end()) {
+          deps.push_back(last->second);
+        }
+        last->second = id;
+      }
+    }
+    nodes_.push_back(
+        std::make_unique<TaskNode<TaskType>>(std::move(name), std::move(deps), std::move(make_input), comm));
+    return NodeRef<OutputOf<TaskType>>{.id = id};
+  }
+
+  static bool IsCommunicating(ppc::task::TypeOfTask type_of_task) {
+    return type_of_task == ppc::task::TypeOfTask::kMPI || type_of_task == ppc::task::TypeOfTask::kALL;
+  }
+
+  void Schedule(RunState &state, ppc::task::AsyncExecutor &executor, std::size_t id);
+  void RunNode(RunState &state, ppc::task::AsyncExecutor &executor, std::size_t id);
+  void ComputeCriticalPath(GraphResults &results) const;
+
+  std::vector<std::unique_ptr<NodeBase>> nodes_;
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+  /// Last MPI or ALL node added on each communicator
+  std::vector<std::pair<MPI_Comm, std::size_t>> last_communicating_nodes_;
+  bool ran_ = false;
+};
+
+}  // namespace ppc::graph
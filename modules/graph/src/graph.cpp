@@ -0,0 +1,155 @@
+#include "graph/include/graph.hpp"
+
+#include <mpi.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "task/include/async_executor.hpp"
+#include "util/include/mpi_threads.hpp"
+
+namespace ppc::graph {
+
+struct TaskGraph::RunState {
+  std::chrono::steady_clock::time_point start;
+  std::vector<std::vector<std::size_t>> successors;
+  std::vector<std::size_t> pending;
+  GraphResults results;
+  /// MPI and ALL nodes run on the thread that called Run() unless MPI provides MPI_THREAD_MULTIPLE
+  bool communicate_on_caller = true;
+  /// Ready nodes waiting for the calling thread
+  std::deque<std::size_t> caller_queue;
+  std::size_t in_flight = 0;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable cv;
+
+  [[nodiscard]] double Elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+};
+
+GraphResults TaskGraph::Run(ppc::task::AsyncExecutor &executor) {
+  if (ran_) {
+    throw std::runtime_error("Task graph already ran; its source inputs were moved into the tasks");
+  }
+  ran_ = true;
+
+  RunState state;
+  state.communicate_on_caller = ppc::util::GetProvidedMpiThreadLevel() < MPI_THREAD_MULTIPLE;
+  state.successors.resize(nodes_.size());
+  state.pending.resize(nodes_.size());
+  state.results.nodes.resize(nodes_.size());
+  for (std::size_t id = 0; id < nodes_.size(); id++) {
+    state.pending[id] = nodes_[id]->GetDeps().size();
+    for (std::size_t dep : nodes_[id]->GetDeps()) {
+      state.successors[dep].push_back(id);
+    }
+    state.results.nodes[id].name = nodes_[id]->GetName();
+    state.results.nodes[id].type_of_task = nodes_[id]->GetTypeOfTask();
+  }
+
+  state.start = std::chrono::steady_clock::now();
+  {
+    const std::scoped_lock lock(state.mutex);
+    for (std::size_t id = 0; id < nodes_.size(); id++) {
+      if (state.pending[id] == 0) {
+        Schedule(state, executor, id);
+      }
+    }
+  }
+
+  std::unique_lock lock(state.mutex);
+  while (true) {
+    state.cv.wait(lock, [&state] { return state.in_flight == 0 || !state.caller_queue.empty(); });
+    if (state.caller_queue.empty()) {
+      break;
+    }
+    const std::size_t id = state.caller_queue.front();
+    state.caller_queue.pop_front();
+    lock.unlock();
+    RunNode(state, executor, id);
+    lock.lock();
+  }
+  state.results.total_sec = state.Elapsed();
+  if (state.error) {
+    std::rethrow_exception(state.error);
+  }
+
+  ComputeCriticalPath(state.results);
+  return std::move(state.results);
+}
+
+// Called with state.mutex held.
+void TaskGraph::Schedule(RunState &state, ppc::task::AsyncExecutor &executor, std::size_t id) {
+  state.in_flight++;
+  if (state.communicate_on_caller && IsCommunicating(nodes_[id]->GetTypeOfTask())) {
+    state.caller_queue.push_back(id);
+    state.cv.notify_all();
+    return;
+  }
+  executor.Post([this, &state, &executor, id] { RunNode(state, executor, id); });
+}
+
+void TaskGraph::RunNode(RunState &state, ppc::task::AsyncExecutor &executor, std::size_t id) {
+  auto &timing = state.results.nodes[id];
+  timing.start_sec = state.Elapsed();
+  std::exception_ptr error;
+  try {
+    nodes_[id]->Execute();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  timing.end_sec = state.Elapsed();
+  timing.stage_timings = nodes_[id]->GetStageTimings();
+
+  const std::scoped_lock lock(state.mutex);
+  if (error && !state.error) {
+    state.error = error;
+  }
+  if (!state.error) {
+    for (std::size_t next : state.successors[id]) {
+      if (--state.pending[next] == 0) {
+        Schedule(state, executor, next);
+      }
+    }
+  }
+  if (--state.in_flight == 0) {
+    state.cv.notify_all();
+  }
+}
+
+void TaskGraph::ComputeCriticalPath(GraphResults &results) const {
+  // Node ids are a topological order because a node may only depend on earlier nodes.
+  std::vector<double> finish(nodes_.size(), 0.0);
+  std::vector<std::optional<std::size_t>> previous(nodes_.size());
+  std::optional<std::size_t> last;
+  for (std::size_t id = 0; id < nodes_.size(); id++) {
+    double ready = 0.0;
+    for (std::size_t dep : nodes_[id]->GetDeps()) {
+      if (finish[dep] > ready || !previous[id]) {
+        ready = finish[dep];
+        previous[id] = dep;
+      }
+    }
+    finish[id] = ready + results.nodes[id].Duration();
+    if (!last || finish[id] > finish[*last]) {
+      last = id;
+    }
+  }
+
+  results.critical_path.clear();
+  results.critical_path_sec = last ? finish[*last] : 0.0;
+  for (auto node = last; node; node = previous[*node]) {
+    results.critical_path.insert(results.critical_path.begin(), *node);
+  }
+}
+
+}  // namespace ppc::graph
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "graph/include/graph.hpp"
+#include "task/include/task.hpp"
+#include "util/include/mpi_threads.hpp"
+
+namespace ppc::test {
+
+class GraphSumTask : public ppc::task::Task<std::vector<int>, int> {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kSEQ;
+  }
+
+  explicit GraphSumTask(std::vector<int> in) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+    GetInput() = std::move(in);
+    GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+  }
+
+ protected:
+  bool ValidationImpl() override {
+    return !GetInput().empty();
+  }
+  bool PreProcessingImpl() override {
+    GetOutput() = 0;
+    return true;
+  }
+  bool RunImpl() override {
+    for (int value : GetInput()) {
+      GetOutput() += value;
+    }
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+};
+
+class GraphSleepTask : public GraphSumTask {
+ public:
+  using GraphSumTask::GraphSumTask;
+
+ protected:
+  bool RunImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return GraphSumTask::RunImpl();
+  }
+};
+
+class GraphMpiTask : public GraphSumTask {
+ public:
+  static constexpr bool kUsesTaskComm = true;
+
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  explicit GraphMpiTask(std::vector<int> in) : GraphSumTask(std::move(in)) {
+    SetTypeOfTask(GetStaticTypeOfTask());
+  }
+
+ protected:
+  bool RunImpl() override {
+    // Records the communicator the node was given instead of communicating on it
+    GetOutput() = GetComm() == MPI_COMM_SELF ? 1 : 0;
+    return true;
+  }
+};
+
+class GraphThreadTask : public GraphMpiTask {
+ public:
+  using GraphMpiTask::GraphMpiTask;
+
+  static std::thread::id last_thread;
+
+ protected:
+  bool RunImpl() override {
+    last_thread = std::this_thread::get_id();
+    return GraphMpiTask::RunImpl();
+  }
+};
+
+std::thread::id GraphThreadTask::last_thread;
+
+class GraphWorldOnlyTask : public GraphSumTask {
+ public:
+  static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+    return ppc::task::TypeOfTask::kMPI;
+  }
+
+  using GraphSumTask::GraphSumTask;
+};
+
+}  // namespace ppc::test
+
+using ppc::graph::TaskGraph;
+using ppc::test::GraphMpiTask;
+using ppc::test::GraphSleepTask;
+using ppc::test::GraphSumTask;
+using ppc::test::GraphThreadTask;
+using ppc::test::GraphWorldOnlyTask;
+
+TEST(GraphTest, WiresOutputsIntoInputs) {
+  TaskGraph graph;
+  auto a = graph.AddSource<GraphSumTask>("a", {1, 2, 3});
+  auto b = graph.AddSource<GraphSumTask>("b", {10, 20});
+  auto c = graph.Add<GraphSumTask>("c", [](int &x, int &y) { return std::vector<int>{x, y}; }, a, b);
+  auto d = graph.Add<GraphSumTask>("d", [](int &x) { return std::vector<int>{x, 1}; }, c);
+  ASSERT_EQ(graph.Size(), 4U);
+
+  const auto results = graph.Run(2);
+  EXPECT_EQ(graph.Output(a), 6);
+  EXPECT_EQ(graph.Output(b), 30);
+  EXPECT_EQ(graph.Output(c), 36);
+  EXPECT_EQ(graph.Output(d), 37);
+
+  ASSERT_EQ(results.nodes.size(), 4U);
+  EXPECT_EQ(results.nodes[2].name, "c");
+  EXPECT_EQ(results.nodes[2].type_of_task, ppc::task::TypeOfTask::kSEQ);
+  for (const auto &node : results.nodes) {
+    EXPECT_GE(node.Duration(), 0.0);
+    EXPECT_LE(node.end_sec, results.total_sec);
+  }
+  EXPECT_GE(results.nodes[2].start_sec, results.nodes[0].end_sec);
+  EXPECT_GE(results.nodes[2].start_sec, results.nodes[1].end_sec);
+  ASSERT_EQ(results.critical_path.size(), 3U);
+  EXPECT_EQ(results.critical_path[1], 2U);
+  EXPECT_EQ(results.critical_path[2], 3U);
+  EXPECT_LE(results.critical_path_sec, results.total_sec);
+}
+
+TEST(GraphTest, MovesIntermediatesWithoutCopies) {
+  class ForwardTask : public ppc::task::Task<std::vector<int>, std::vector<int>> {
+   public:
+    static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
+      return ppc::task::TypeOfTask::kSEQ;
+    }
+    explicit ForwardTask(std::vector<int> in) {
+      GetInput() = std::move(in);
+      GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    }
+
+   protected:
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      GetOutput() = std::move(GetInput());
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+
+  std::vector<int> data(1000, 1);
+  const int *ptr = data.data();
+  TaskGraph graph;
+  auto first = graph.AddSource<ForwardTask>("first", std::move(data));
+  auto second = graph.Add<ForwardTask>("second", [](std::vector<int> &out) { return std::move(out); }, first);
+  graph.Run(1);
+  EXPECT_EQ(graph.Output(second).data(), ptr);
+}
+
+TEST(GraphTest, RunsIndependentNodesConcurrently) {
+  TaskGraph graph;
+  for (int i = 0; i < 4; i++) {
+    graph.AddSource<GraphSleepTask>("sleep_" + std::to_string(i), {i});
+  }
+  const auto results = graph.Run(4);
+  // Every node starts before any other node ends, so all four were running at once
+  double last_start = 0.0;
+  double first_end = results.total_sec;
+  for (const auto &node : results.nodes) {
+    last_start = std::max(last_start, node.start_sec);
+    first_end = std::min(first_end, node.end_sec);
+  }
+  EXPECT_LT(last_start, first_end);
+  EXPECT_EQ(results.critical_path.size(), 1U);
+}
+
+TEST(GraphTest, RunsOnlyOnce) {
+  TaskGraph graph;
+  auto a = graph.AddSource<GraphSumTask>("a", {1, 2});
+  graph.Run(1);
+  EXPECT_THROW(graph.Run(1), std::runtime_error);
+  EXPECT_EQ(graph.Output(a), 3);
+}
+
+TEST(GraphTest, FailedNodeStopsDependents) {
+  TaskGraph graph;
+  auto empty = graph.AddSource<GraphSumTask>("empty", {});
+  auto next = graph.Add<GraphSumTask>("next", [](int &x) { return std::vector<int>{x}; }, empty);
+  EXPECT_THROW(graph.Run(2), std::runtime_error);
+  EXPECT_THROW(graph.Output(next), std::runtime_error);
+}
+
+TEST(GraphTest, RunsCommunicatingNodesOnTheirCommunicator) {
+  TaskGraph graph;
+  auto world_first = graph.AddSource<GraphMpiTask>("world_first", {1});
+  graph.SetComm(MPI_COMM_SELF);
+  auto self_first = graph.AddSource<GraphMpiTask>("self_first", {1});
+  auto self_second = graph.AddSource<GraphMpiTask>("self_second", {1});
+  EXPECT_THROW(graph.AddSource<GraphWorldOnlyTask>("world_only", {1}), std::invalid_argument);
+
+  const auto results = graph.Run(2);
+  EXPECT_EQ(graph.Output(world_first), 0);
+  EXPECT_EQ(graph.Output(self_first), 1);
+  EXPECT_EQ(graph.Output(self_second), 1);
+  // Nodes on one communicator keep the order they were added in
+  EXPECT_GE(results.nodes[self_second.id].start_sec, results.nodes[self_first.id].end_sec);
+}
+
+TEST(GraphTest, RunsCommunicatingNodesOnTheCallingThreadWithoutThreadedMpi) {
+  if (ppc::util::GetProvidedMpiThreadLevel() == MPI_THREAD_MULTIPLE) {
+    GTEST_SKIP() << "MPI nodes may run on the workers with MPI_THREAD_MULTIPLE";
+  }
+  TaskGraph graph;
+  auto source = graph.AddSource<GraphSleepTask>("source", {1});
+  graph.Add<GraphThreadTask>("mpi", [](int &x) { return std::vector<int>{x}; }, source);
+  graph.Run(2);
+  EXPECT_EQ(GraphThreadTask::last_thread, std::this_thread::get_id());
+}
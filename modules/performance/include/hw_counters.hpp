@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::performance {
+
+/// @brief Hardware and OS events collected around timed regions.
+enum class HwCounter : uint8_t {
+  kCycles,
+  kInstructions,
+  kLlcMisses,
+  kBranchMisses,
+  kDtlbMisses,
+  kContextSwitches,
+};
+
+inline constexpr std::size_t kNumHwCounters = 6;
+
+inline constexpr std::array<std::string_view, kNumHwCounters> kHwCounterNames = {
+    "cycles", "instructions", "llc_misses", "branch_misses", "dtlb_misses", "context_switches"};
+
+/// @brief Accumulated counter values of one process.
+struct HwCounterValues {
+  /// @brief Event counts, scaled for multiplexing.
+  std::array<uint64_t, kNumHwCounters> values{};
+  /// @brief Whether the corresponding event could be opened.
+  std::array<bool, kNumHwCounters> available{};
+  /// @brief Empty when all events are available, otherwise explains what is missing.
+  std::string status;
+
+  [[nodiscard]] uint64_t Get(HwCounter counter) const {
+    return values[static_cast<std::size_t>(counter)];
+  }
+  [[nodiscard]] bool IsAvailable(HwCounter counter) const {
+    return available[static_cast<std::size_t>(counter)];
+  }
+  [[nodiscard]] bool AnyAvailable() const {
+    for (bool a : available) {
+      if (a) {
+        return true;
+      }
+    }
+    return false;
+  }
+  /// @brief Instructions per cycle or 0.0 if either counter is missing.
+  [[nodiscard]] double Ipc() const {
+    if (!IsAvailable(HwCounter::kCycles) || !IsAvailable(HwCounter::kInstructions) || Get(HwCounter::kCycles) == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(Get(HwCounter::kInstructions)) / static_cast<double>(Get(HwCounter::kCycles));
+  }
+};
+
+/// @brief Counter backend built on Linux perf_event_open.
+/// @details Events are opened for every thread of the process that exists at construction time and are inherited by
+/// threads created later, so OpenMP/TBB/STL workers are aggregated into one set of values. Construct it after the
+/// thread pools are warmed up. If the kernel refuses an event (no PMU, perf_event_paranoid, non-Linux platform) the
+/// event is reported as unavailable instead of failing.
+class HwCounters {
+ public:
+  HwCounters();
+  ~HwCounters();
+  HwCounters(const HwCounters &) = delete;
+  HwCounters &operator=(const HwCounters &) = delete;
+
+  /// @brief Starts counting.
+  void Start();
+  /// @brief Stops counting; values keep accumulating across Start/Stop pairs.
+  void Stop();
+  /// @brief Returns the values accumulated so far.
+  [[nodiscard]] HwCounterValues Read() const;
+
+ private:
+  struct Event {
+    int fd;
+    std::size_t counter;
+  };
+  std::vector<Event> events_;
+  std::array<bool, kNumHwCounters> available_{};
+  std::string status_;
+};
+
+}  // namespace ppc::performance
@@ -1,40 +1,232 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "performance/include/hw_counters.hpp"
 #include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/memory.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::performance {
 
-inline double DefaultTimer() {
-  return -1.0;
-}
+struct PerfResults;
 
 struct PerfAttr {
   /// @brief Number of times the task is run for performance evaluation.
+  /// @details In adaptive mode this is the minimum number of timed iterations.
   uint64_t num_running = 5;
+  /// @brief Number of untimed iterations executed before measuring.
+  uint64_t num_warmup = 0;
+  /// @brief Keeps running until the median confidence interval is narrow enough or the budget is spent.
+  bool adaptive = false;
+  /// @brief Adaptive mode: target relative half-width of the 95% confidence interval of the median.
+  double target_rel_ci = 0.02;
+  /// @brief Adaptive mode: upper bound on the number of timed iterations.
+  uint64_t max_running = 1000;
+  /// @brief Adaptive mode: time budget in seconds for all timed iterations.
+  double max_time_sec = ppc::util::GetPerfMaxTime();
+  /// @brief Collects hardware counters around every timed iteration.
+  bool hw_counters = false;
   /// @brief Timer function returning current time in seconds.
   /// @cond
-  std::function<double()> current_timer = DefaultTimer;
+  std::function<double()> current_timer = ppc::util::Clock::Now;
+  /// @endcond
+  /// @brief Combines the local adaptive stop decision across processes so that all of them stop together.
+  /// @cond
+  std::function<bool(bool)> stop_decision = [](bool stop) { return stop; };
+  /// @endcond
+  /// @brief Called before every timed iteration, e.g. to align the start of all processes on a barrier.
+  /// @cond
+  std::function<void()> sync_start = [] {};
+  /// @endcond
+  /// @brief Combines the local samples of all processes before the statistics are computed.
+  /// @cond
+  std::function<void(PerfResults &)> reduce_results = [](PerfResults & /*perf_results*/) {};
   /// @endcond
 };
 
+/// @brief Spread of the per-iteration time across processes.
+struct RankTimes {
+  /// @brief Number of processes that took part in the measurement.
+  int num_ranks = 1;
+  /// @brief Mean iteration time of the fastest process in seconds.
+  double min_sec = 0.0;
+  /// @brief Mean iteration time of the slowest process in seconds.
+  double max_sec = 0.0;
+  /// @brief Mean iteration time averaged over all processes in seconds.
+  double mean_sec = 0.0;
+  /// @brief Load imbalance ratio max_sec / mean_sec; 1.0 means perfectly balanced.
+  double imbalance = 1.0;
+};
+
+/// @brief Heap and resident memory usage of the timed iterations.
+struct MemoryStats {
+  /// @brief Whether allocation counting was active; allocation figures are zero otherwise.
+  bool allocation_hooks = false;
+  /// @brief Mean number of heap allocations per timed iteration, summed over processes.
+  double allocations_per_iteration = 0.0;
+  /// @brief Mean number of heap-allocated bytes per timed iteration, summed over processes.
+  double bytes_per_iteration = 0.0;
+  /// @brief Peak resident set size in bytes, the maximum over processes.
+  uint64_t peak_rss_bytes = 0;
+  /// @brief Mean allocations of every pipeline stage per timed iteration on this process.
+  ppc::task::StageAllocations stage_allocations;
+  /// @brief Largest peak resident set size of every pipeline stage over the timed iterations on this process.
+  ppc::task::StagePeakRss stage_peak_rss;
+};
+
 struct PerfResults {
-  /// @brief Measured execution time in seconds.
+  /// @brief Measured execution time in seconds (mean over all iterations).
   double time_sec = 0.0;
+  /// @brief Execution time of every timed iteration in seconds.
+  std::vector<double> samples;
+  /// @brief Fastest iteration in seconds.
+  double min_sec = 0.0;
+  /// @brief Median iteration time in seconds.
+  double median_sec = 0.0;
+  /// @brief Mean iteration time in seconds.
+  double mean_sec = 0.0;
+  /// @brief 90th percentile of iteration times in seconds.
+  double p90_sec = 0.0;
+  /// @brief 99th percentile of iteration times in seconds.
+  double p99_sec = 0.0;
+  /// @brief Sample standard deviation of iteration times in seconds.
+  double stddev_sec = 0.0;
+  /// @brief Relative half-width of the 95% confidence interval of the median.
+  double median_rel_ci = 0.0;
+  /// @brief Hardware counters summed over all timed iterations, if requested.
+  std::optional<HwCounterValues> hw_counters;
+  /// @brief Per-process time spread, filled by PerfAttr::reduce_results for multi-process runs.
+  std::optional<RankTimes> rank_times;
+  /// @brief Mean duration of every pipeline stage per timed iteration.
+  /// @details In task_run mode only the Run stage is repeated; the other stages are taken from the surrounding pass.
+  ppc::task::StageTimings stage_timings;
+  /// @brief Allocation and resident memory figures, reduced over processes by PerfAttr::reduce_results.
+  MemoryStats memory;
   enum class TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone };
   TypeOfRunning type_of_running = TypeOfRunning::kNone;
   constexpr static double kMaxTime = 10.0;
 };
 
+/// @brief Returns the q-quantile of sorted samples using linear interpolation.
+/// @param sorted_samples Samples in ascending order.
+/// @param q Quantile in range [0, 1].
+/// @return Interpolated quantile value or 0.0 if there are no samples.
+inline double Percentile(const std::vector<double> &sorted_samples, double q) {
+  if (sorted_samples.empty()) {
+    return 0.0;
+  }
+  const double pos = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted_samples.size() - 1);
+  const auto lower = static_cast<std::size_t>(std::floor(pos));
+  const auto upper = static_cast<std::size_t>(std::ceil(pos));
+  const double frac = pos - static_cast<double>(lower);
+  return sorted_samples[lower] + ((sorted_samples[upper] - sorted_samples[lower]) * frac);
+}
+
+/// @brief Returns the relative half-width of the distribution-free 95% confidence interval of the median.
+/// @param sorted_samples Samples in ascending order.
+/// @return Half-width of the interval divided by the median or 0.0 if it cannot be estimated.
+inline double MedianRelativeCI(const std::vector<double> &sorted_samples) {
+  const std::size_t n = sorted_samples.size();
+  if (n < 2) {
+    return 0.0;
+  }
+  constexpr double kZ = 1.96;
+  const double half_n = static_cast<double>(n) / 2.0;
+  const double spread = kZ * std::sqrt(static_cast<double>(n)) / 2.0;
+  // 1-based ranks of the order statistics bounding the median
+  const auto lower_rank = static_cast<std::size_t>(std::max(1.0, std::floor(half_n - spread)));
+  const auto upper_rank = static_cast<std::size_t>(std::min(static_cast<double>(n), std::ceil(1.0 + half_n + spread)));
+  const double median = Percentile(sorted_samples, 0.5);
+  if (median <= 0.0) {
+    return 0.0;
+  }
+  return (sorted_samples[upper_rank - 1] - sorted_samples[lower_rank - 1]) / (2.0 * median);
+}
+
+/// @brief Fills the distribution statistics of perf_results from its samples.
+/// @param perf_results Results with collected samples.
+inline void ComputeStatistics(PerfResults &perf_results) {
+  const auto &samples = perf_results.samples;
+  if (samples.empty()) {
+    perf_results.time_sec = perf_results.min_sec = perf_results.median_sec = perf_results.mean_sec = 0.0;
+    perf_results.p90_sec = perf_results.p99_sec = perf_results.stddev_sec = perf_results.median_rel_ci = 0.0;
+    return;
+  }
+
+  std::vector<double> sorted = samples;
+  std::ranges::sort(sorted);
+
+  double sum = 0.0;
+  for (double sample : sorted) {
+    sum += sample;
+  }
+  const auto count = static_cast<double>(sorted.size());
+  const double mean = sum / count;
+
+  double sq_sum = 0.0;
+  for (double sample : sorted) {
+    sq_sum += (sample - mean) * (sample - mean);
+  }
+
+  perf_results.min_sec = sorted.front();
+  perf_results.median_sec = Percentile(sorted, 0.5);
+  perf_results.mean_sec = mean;
+  perf_results.p90_sec = Percentile(sorted, 0.9);
+  perf_results.p99_sec = Percentile(sorted, 0.99);
+  perf_results.stddev_sec = sorted.size() > 1 ? std::sqrt(sq_sum / (count - 1.0)) : 0.0;
+  perf_results.median_rel_ci = MedianRelativeCI(sorted);
+  perf_results.time_sec = mean;
+}
+
+/// @brief Formats counter values as a comma-separated key=value list.
+/// @param values Counter values to format.
+/// @return Formatted string; unavailable counters are printed as "n/a".
+inline std::string FormatHwCounters(const HwCounterValues &values) {
+  std::stringstream counters_str;
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    counters_str << (i == 0 ? "" : ",") << kHwCounterNames[i] << "=";
+    if (values.available[i]) {
+      counters_str << values.values[i];
+    } else {
+      counters_str << "n/a";
+    }
+  }
+  counters_str << ",ipc=" << std::fixed << std::setprecision(3) << values.Ipc();
+  return counters_str.str();
+}
+
+/// @brief Formats memory figures as a comma-separated key=value list.
+/// @param memory Memory figures to format.
+/// @return Formatted string; allocation figures are printed as "n/a" when the allocation hooks are not linked.
+inline std::string FormatMemoryStats(const MemoryStats &memory) {
+  std::stringstream memory_str;
+  memory_str << std::fixed << std::setprecision(1);
+  if (memory.allocation_hooks) {
+    memory_str << "allocs_per_iter=" << memory.allocations_per_iteration
+               << ",bytes_per_iter=" << memory.bytes_per_iteration;
+  } else {
+    memory_str << "allocs_per_iter=n/a,bytes_per_iter=n/a";
+  }
+  constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+  memory_str << ",peak_rss_mib=" << static_cast<double>(memory.peak_rss_bytes) / kBytesPerMiB
+             << ",run_peak_rss_mib=" << static_cast<double>(memory.stage_peak_rss.run) / kBytesPerMiB;
+  return memory_str.str();
+}
+
 template <typename InType, typename OutType>
 class Perf {
  public:
@@ -47,12 +239,42 @@ class Perf {
   void PipelineRun(const PerfAttr &perf_attr) {
     perf_results_.type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
+    ppc::task::StageTimings stage_sum;
+    ppc::task::StageAllocations allocation_sum;
+    auto &peak_rss = perf_results_.memory.stage_peak_rss;
+    peak_rss = {};
     CommonRun(perf_attr, [&] {
       task_->Validation();
       task_->PreProcessing();
       task_->Run();
       task_->PostProcessing();
-    }, perf_results_);
+    }, perf_results_, [&] {
+      const auto &stages = task_->GetStageTimings();
+      stage_sum.validation_sec += stages.validation_sec;
+      stage_sum.preprocessing_sec += stages.preprocessing_sec;
+      stage_sum.run_sec += stages.run_sec;
+      stage_sum.postprocessing_sec += stages.postprocessing_sec;
+      const auto &allocations = task_->GetStageAllocations();
+      allocation_sum.validation += allocations.validation;
+      allocation_sum.preprocessing += allocations.preprocessing;
+      allocation_sum.run += allocations.run;
+      allocation_sum.postprocessing += allocations.postprocessing;
+      const auto &stage_peak_rss = task_->GetStagePeakRss();
+      peak_rss.validation = std::max(peak_rss.validation, stage_peak_rss.validation);
+      peak_rss.preprocessing = std::max(peak_rss.preprocessing, stage_peak_rss.preprocessing);
+      peak_rss.run = std::max(peak_rss.run, stage_peak_rss.run);
+      peak_rss.postprocessing = std::max(peak_rss.postprocessing, stage_peak_rss.postprocessing);
+    });
+    const auto count = static_cast<double>(std::max<std::size_t>(perf_results_.samples.size(), 1));
+    perf_results_.stage_timings = {.validation_sec = stage_sum.validation_sec / count,
+                                   .preprocessing_sec = stage_sum.preprocessing_sec / count,
+                                   .run_sec = stage_sum.run_sec / count,
+                                   .postprocessing_sec = stage_sum.postprocessing_sec / count};
+    const auto samples = std::max<uint64_t>(perf_results_.samples.size(), 1);
+    perf_results_.memory.stage_allocations = {.validation = PerIteration(allocation_sum.validation, samples),
+                                              .preprocessing = PerIteration(allocation_sum.preprocessing, samples),
+                                              .run = PerIteration(allocation_sum.run, samples),
+                                              .postprocessing = PerIteration(allocation_sum.postprocessing, samples)};
   }
   // Check performance of task's Run() function
   void TaskRun(const PerfAttr &perf_attr) {
@@ -60,8 +282,23 @@ class Perf {
 
     task_->Validation();
     task_->PreProcessing();
-    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_);
+    double run_sum = 0.0;
+    ppc::util::AllocationCounters run_allocations;
+    auto &peak_rss = perf_results_.memory.stage_peak_rss;
+    peak_rss = task_->GetStagePeakRss();
+    peak_rss.run = 0;
+    CommonRun(perf_attr, [&] { task_->Run(); }, perf_results_, [&] {
+      run_sum += task_->GetStageTimings().run_sec;
+      run_allocations += task_->GetStageAllocations().run;
+      peak_rss.run = std::max(peak_rss.run, task_->GetStagePeakRss().run);
+    });
     task_->PostProcessing();
+    perf_results_.stage_timings = task_->GetStageTimings();
+    perf_results_.stage_timings.run_sec =
+        run_sum / static_cast<double>(std::max<std::size_t>(perf_results_.samples.size(), 1));
+    perf_results_.memory.stage_allocations = task_->GetStageAllocations();
+    perf_results_.memory.stage_allocations.run =
+        PerIteration(run_allocations, std::max<uint64_t>(perf_results_.samples.size(), 1));
 
     task_->Validation();
     task_->PreProcessing();
@@ -87,6 +324,7 @@ class Perf {
     if (time_secs < max_time) {
       perf_res_str << std::fixed << std::setprecision(10) << time_secs;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistic(test_id, type_test_name);
     } else {
       std::stringstream err_msg;
       err_msg << '\n' << "Task execute time need to be: ";
@@ -94,6 +332,7 @@ class Perf {
       err_msg << "Original time in secs: " << time_secs << '\n';
       perf_res_str << std::fixed << std::setprecision(10) << -1.0;
       std::cout << test_id << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+      PrintSampleStatistic(test_id, type_test_name);
       throw std::runtime_error(err_msg.str().c_str());
     }
   }
@@ -106,13 +345,106 @@ class Perf {
  private:
   PerfResults perf_results_;
   std::shared_ptr<ppc::task::Task<InType, OutType>> task_;
-  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results) {
-    auto begin = perf_attr.current_timer();
-    for (uint64_t i = 0; i < perf_attr.num_running; i++) {
+  static void CommonRun(const PerfAttr &perf_attr, const std::function<void()> &pipeline, PerfResults &perf_results,
+                        const std::function<void()> &on_sample = [] {}) {
+    for (uint64_t i = 0; i < perf_attr.num_warmup; i++) {
+      pipeline();
+    }
+
+    // Opened after the warm-up so that already spawned worker threads are counted
+    std::optional<HwCounters> counters;
+    if (perf_attr.hw_counters) {
+      counters.emplace();
+    }
+
+    perf_results.samples.clear();
+    perf_results.samples.reserve(perf_attr.num_running);
+    const auto allocations_begin = ppc::util::ReadAllocationCounters();
+    const auto budget_begin = perf_attr.adaptive ? perf_attr.current_timer() : 0.0;
+    while (perf_attr.adaptive || perf_results.samples.size() < perf_attr.num_running) {
+      perf_attr.sync_start();
+      if (counters) {
+        counters->Start();
+      }
+      auto begin = perf_attr.current_timer();
       pipeline();
+      auto end = perf_attr.current_timer();
+      if (counters) {
+        counters->Stop();
+      }
+      perf_results.samples.push_back(end - begin);
+      on_sample();
+      if (perf_attr.adaptive && AdaptiveShouldStop(perf_attr, perf_results.samples, end - budget_begin)) {
+        break;
+      }
+    }
+    const auto allocations = ppc::util::ReadAllocationCounters() - allocations_begin;
+    const auto iterations = static_cast<double>(std::max<std::size_t>(perf_results.samples.size(), 1));
+    perf_results.memory.allocation_hooks = ppc::util::AllocationHooksLinked();
+    perf_results.memory.allocations_per_iteration = static_cast<double>(allocations.count) / iterations;
+    perf_results.memory.bytes_per_iteration = static_cast<double>(allocations.bytes) / iterations;
+    // Every stage resets the high-water mark, so the mark alone only covers the time since the last stage started
+    perf_results.memory.peak_rss_bytes =
+        std::max(ppc::util::GetPeakRssBytes(), perf_results.memory.stage_peak_rss.Max());
+
+    perf_results.rank_times.reset();
+    perf_attr.reduce_results(perf_results);
+    ComputeStatistics(perf_results);
+    perf_results.hw_counters.reset();
+    if (counters) {
+      perf_results.hw_counters = counters->Read();
+    }
+  }
+  static ppc::util::AllocationCounters PerIteration(const ppc::util::AllocationCounters &sum, uint64_t iterations) {
+    return {.count = sum.count / iterations, .bytes = sum.bytes / iterations};
+  }
+  static bool AdaptiveShouldStop(const PerfAttr &perf_attr, const std::vector<double> &samples, double elapsed) {
+    const auto count = static_cast<uint64_t>(samples.size());
+    bool stop = count >= perf_attr.max_running || elapsed >= perf_attr.max_time_sec;
+    if (!stop && count >= perf_attr.num_running) {
+      std::vector<double> sorted = samples;
+      std::ranges::sort(sorted);
+      stop = MedianRelativeCI(sorted) <= perf_attr.target_rel_ci;
+    }
+    return perf_attr.stop_decision(stop);
+  }
+  // Print the per-iteration distribution next to the main result line
+  void PrintSampleStatistic(const std::string &test_id, const std::string &type_test_name) const {
+    std::stringstream stat_str;
+    stat_str << std::fixed << std::setprecision(10);
+    stat_str << "min=" << perf_results_.min_sec << ",median=" << perf_results_.median_sec
+             << ",mean=" << perf_results_.mean_sec << ",p90=" << perf_results_.p90_sec
+             << ",p99=" << perf_results_.p99_sec << ",stddev=" << perf_results_.stddev_sec
+             << ",median_rel_ci=" << perf_results_.median_rel_ci << ",samples=" << perf_results_.samples.size();
+    std::cout << test_id << ":" << type_test_name << ":stats:" << stat_str.str() << '\n';
+    const auto &stages = perf_results_.stage_timings;
+    std::stringstream stage_str;
+    stage_str << std::fixed << std::setprecision(10) << "validation=" << stages.validation_sec
+              << ",preprocessing=" << stages.preprocessing_sec << ",run=" << stages.run_sec
+              << ",postprocessing=" << stages.postprocessing_sec;
+    std::cout << test_id << ":" << type_test_name << ":stages:" << stage_str.str() << '\n';
+    if (perf_results_.rank_times) {
+      const auto &rank_times = *perf_results_.rank_times;
+      std::stringstream rank_str;
+      rank_str << std::fixed << std::setprecision(10) << "num=" << rank_times.num_ranks << ",min=" << rank_times.min_sec
+               << ",max=" << rank_times.max_sec << ",mean=" << rank_times.mean_sec << std::setprecision(4)
+               << ",imbalance=" << rank_times.imbalance;
+      std::cout << test_id << ":" << type_test_name << ":ranks:" << rank_str.str() << '\n';
+    }
+    const auto &clock_info = ppc::util::Clock::GetInfo();
+    std::stringstream clock_str;
+    clock_str << "source=" << ppc::util::GetStringClockSource(clock_info.source) << std::scientific << std::setprecision(3)
+              << ",resolution=" << clock_info.resolution_sec << ",overhead=" << clock_info.overhead_sec;
+    std::cout << test_id << ":" << type_test_name << ":clock:" << clock_str.str() << '\n';
+    std::cout << test_id << ":" << type_test_name << ":memory:" << FormatMemoryStats(perf_results_.memory) << '\n';
+    if (perf_results_.hw_counters) {
+      std::cout << test_id << ":" << type_test_name << ":counters:" << FormatHwCounters(*perf_results_.hw_counters)
+                << '\n';
+      if (!perf_results_.hw_counters->status.empty()) {
+        std::cout << test_id << ":" << type_test_name << ":counters_status:" << perf_results_.hw_counters->status
+                  << '\n';
+      }
     }
-    auto end = perf_attr.current_timer();
-    perf_results.time_sec = (end - begin) / static_cast<double>(perf_attr.num_running);
   }
 };
 
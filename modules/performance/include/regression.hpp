@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+
+namespace ppc::performance {
+
+/// @brief Outcome of comparing a measurement with its baseline.
+enum class RegressionVerdict : uint8_t {
+  /// The median is within the tolerance of the baseline or faster
+  kPass,
+  /// The median is slower than the tolerance allows and the difference is statistically significant
+  kFail,
+  /// The median is slower than the tolerance allows but the samples do not differ significantly
+  kNoise
+};
+
+/// @brief Result of CompareWithBaseline().
+struct RegressionCheck {
+  RegressionVerdict verdict = RegressionVerdict::kNoise;
+  /// New median divided by the baseline median
+  double ratio = 1.0;
+  /// Two-sided p-value of the Mann-Whitney U test
+  double p_value = 1.0;
+};
+
+/// @brief Returns the two-sided p-value of the Mann-Whitney U test for two independent samples.
+/// @details Uses the normal approximation with tie and continuity corrections, which is adequate from about five
+/// samples per group. Unlike a t-test it does not assume normally distributed timings.
+/// @return p-value in [0, 1]; 1.0 if either sample is empty or all values are equal.
+inline double MannWhitneyPValue(const std::vector<double> &a, const std::vector<double> &b) {
+  const std::size_t n1 = a.size();
+  const std::size_t n2 = b.size();
+  if (n1 == 0 || n2 == 0) {
+    return 1.0;
+  }
+
+  // Values tagged with their group, ranked with ties sharing the average rank
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(n1 + n2);
+  for (double value : a) {
+    pooled.emplace_back(value, true);
+  }
+  for (double value : b) {
+    pooled.emplace_back(value, false);
+  }
+  std::ranges::sort(pooled, {}, &std::pair<double, bool>::first);
+
+  const auto n = static_cast<double>(n1 + n2);
+  double rank_sum_a = 0.0;
+  double tie_term = 0.0;
+  for (std::size_t i = 0; i < pooled.size();) {
+    std::size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      j++;
+    }
+    const double average_rank = (static_cast<double>(i + 1) + static_cast<double>(j)) / 2.0;
+    const auto ties = static_cast<double>(j - i);
+    tie_term += (ties * ties * ties) - ties;
+    for (std::size_t k = i; k < j; k++) {
+      if (pooled[k].second) {
+        rank_sum_a += average_rank;
+      }
+    }
+    i = j;
+  }
+
+  const auto dn1 = static_cast<double>(n1);
+  const auto dn2 = static_cast<double>(n2);
+  const double u = rank_sum_a - (dn1 * (dn1 + 1.0) / 2.0);
+  const double mean = dn1 * dn2 / 2.0;
+  const double variance = dn1 * dn2 / 12.0 * ((n + 1.0) - (tie_term / (n * (n - 1.0))));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  const double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+  return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+}
+
+/// @brief Compares new samples with baseline samples.
+/// @param baseline_samples Iteration times of the baseline run.
+/// @param samples Iteration times of the new run.
+/// @param tolerance Accepted relative slowdown of the median, e.g. 0.1 for 10%.
+/// @param alpha Significance level of the Mann-Whitney U test.
+inline RegressionCheck CompareWithBaseline(const std::vector<double> &baseline_samples,
+                                           const std::vector<double> &samples, double tolerance,
+                                           double alpha = 0.05) {
+  RegressionCheck check;
+  std::vector<double> sorted_baseline = baseline_samples;
+  std::vector<double> sorted_samples = samples;
+  std::ranges::sort(sorted_baseline);
+  std::ranges::sort(sorted_samples);
+  const double baseline_median = Percentile(sorted_baseline, 0.5);
+  if (baseline_median <= 0.0 || sorted_samples.empty()) {
+    return check;
+  }
+  check.ratio = Percentile(sorted_samples, 0.5) / baseline_median;
+  check.p_value = MannWhitneyPValue(sorted_baseline, sorted_samples);
+  if (check.ratio <= 1.0 + tolerance) {
+    check.verdict = RegressionVerdict::kPass;
+  } else if (check.p_value < alpha) {
+    check.verdict = RegressionVerdict::kFail;
+  } else {
+    check.verdict = RegressionVerdict::kNoise;
+  }
+  return check;
+}
+
+inline std::string GetStringVerdict(RegressionVerdict verdict) {
+  if (verdict == RegressionVerdict::kPass) {
+    return "pass";
+  }
+  if (verdict == RegressionVerdict::kFail) {
+    return "fail";
+  }
+  return "noise";
+}
+
+}  // namespace ppc::performance
@@ -0,0 +1,162 @@
+#include "performance/include/hw_counters.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cerrno>
+#  include <charconv>
+#  include <filesystem>
+#  include <system_error>
+#endif
+
+namespace ppc::performance {
+
+#ifdef __linux__
+
+namespace {
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t CacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8U) | (result << 16U);
+}
+
+constexpr std::array<EventConfig, kNumHwCounters> kEventConfigs = {{
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CPU_CYCLES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_INSTRUCTIONS},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_CACHE_MISSES},
+    {.type = PERF_TYPE_HARDWARE, .config = PERF_COUNT_HW_BRANCH_MISSES},
+    {.type = PERF_TYPE_HW_CACHE,
+     .config = CacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {.type = PERF_TYPE_SOFTWARE, .config = PERF_COUNT_SW_CONTEXT_SWITCHES},
+}};
+
+int OpenEvent(const EventConfig &event_config, int tid) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = event_config.type;
+  attr.config = event_config.config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::vector<int> ListThreads() {
+  std::vector<int> tids;
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+    const std::string name = entry.path().filename().string();
+    int tid = 0;
+    const auto [ptr, err] = std::from_chars(name.data(), name.data() + name.size(), tid);
+    if (err == std::errc{} && ptr == name.data() + name.size()) {
+      tids.push_back(tid);
+    }
+  }
+  if (tids.empty()) {
+    tids.push_back(0);
+  }
+  return tids;
+}
+
+}  // namespace
+
+HwCounters::HwCounters() {
+  const auto tids = ListThreads();
+  std::string first_error;
+  for (std::size_t counter = 0; counter < kNumHwCounters; counter++) {
+    bool opened_any = false;
+    for (int tid : tids) {
+      const int fd = OpenEvent(kEventConfigs[counter], tid);
+      if (fd >= 0) {
+        events_.push_back({.fd = fd, .counter = counter});
+        opened_any = true;
+      } else if (first_error.empty()) {
+        first_error = std::error_code(errno, std::generic_category()).message();
+      }
+    }
+    available_[counter] = opened_any;
+    if (!opened_any) {
+      status_ += (status_.empty() ? "unavailable: " : ", ") + std::string(kHwCounterNames[counter]);
+    }
+  }
+  if (!status_.empty()) {
+    status_ += " (" + first_error + ")";
+  }
+}
+
+HwCounters::~HwCounters() {
+  for (const auto &event : events_) {
+    close(event.fd);
+  }
+}
+
+void HwCounters::Start() {
+  for (const auto &event : events_) {
+    ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void HwCounters::Stop() {
+  for (const auto &event : events_) {
+    ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
+}
+
+HwCounterValues HwCounters::Read() const {
+  HwCounterValues result;
+  result.available = available_;
+  result.status = status_;
+  for (const auto &event : events_) {
+    // value, time_enabled, time_running
+    std::array<uint64_t, 3> data{};
+    if (read(event.fd, data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+      continue;
+    }
+    uint64_t value = data[0];
+    if (data[2] == 0) {
+      value = 0;
+    } else if (data[2] < data[1]) {
+      // The event was multiplexed with others: extrapolate to the full enabled time
+      value = static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(data[1]) /
+                                    static_cast<double>(data[2]));
+    }
+    result.values[event.counter] += value;
+  }
+  return result;
+}
+
+#else
+
+HwCounters::HwCounters() : status_("unavailable: hardware counters are supported on Linux only") {}
+
+HwCounters::~HwCounters() = default;
+
+void HwCounters::Start() {}
+
+void HwCounters::Stop() {}
+
+HwCounterValues HwCounters::Read() const {
+  HwCounterValues result;
+  result.available = available_;
+  result.status = status_;
+  return result;
+}
+
+#endif
+
+}  // namespace ppc::performance
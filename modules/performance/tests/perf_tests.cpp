@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -10,10 +13,15 @@
 #include <stdexcept>
 #include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "performance/include/hw_counters.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/regression.hpp"
 #include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/memory.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -102,12 +110,8 @@ TEST(PerfTests, SlowPerfRespectsEnvOverride) {
   Perf<std::vector<uint8_t>, uint8_t> perf_analyzer(test_task);
   PerfAttr perf_attr;
   perf_attr.num_running = 1;
-  const auto t0 = std::chrono::high_resolution_clock::now();
-  perf_attr.current_timer = [&] {
-    auto current_time_point = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
-    return static_cast<double>(duration) * 1e-9;
-  };
+  const double t0 = ppc::util::Clock::Now();
+  perf_attr.current_timer = [t0] { return ppc::util::Clock::Now() - t0; };
   perf_analyzer.PipelineRun(perf_attr);
   EXPECT_NO_THROW(perf_analyzer.PrintPerfStatistic("slow_perf_respects_env_override"));
 }
@@ -350,6 +354,361 @@ TEST(PerfTest, PipelineRunAndTaskRun) {
   EXPECT_GT(res_taskrun.time_sec, 0.0);
 }
 
+TEST(PerfTest, CollectsPerIterationSamples) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 5;
+  // Iteration i takes (i + 1) seconds: samples are 1, 2, 3, 4, 5
+  double time = 0.0;
+  uint64_t calls = 0;
+  attr.current_timer = [&]() {
+    if (calls % 2 == 1) {
+      time += static_cast<double>((calls / 2) + 1);
+    }
+    calls++;
+    return time;
+  };
+
+  perf.PipelineRun(attr);
+  auto res = perf.GetPerfResults();
+  ASSERT_EQ(res.samples.size(), 5U);
+  EXPECT_DOUBLE_EQ(res.samples.front(), 1.0);
+  EXPECT_DOUBLE_EQ(res.samples.back(), 5.0);
+  EXPECT_DOUBLE_EQ(res.min_sec, 1.0);
+  EXPECT_DOUBLE_EQ(res.median_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.mean_sec, 3.0);
+  EXPECT_DOUBLE_EQ(res.time_sec, res.mean_sec);
+  EXPECT_NEAR(res.p90_sec, 4.6, 1e-12);
+  EXPECT_NEAR(res.p99_sec, 4.96, 1e-12);
+  EXPECT_NEAR(res.stddev_sec, std::sqrt(2.5), 1e-12);
+}
+
+TEST(PerfTest, PercentileHandlesEdgeCases) {
+  EXPECT_DOUBLE_EQ(Percentile({}, 0.5), 0.0);
+  EXPECT_DOUBLE_EQ(Percentile({7.0}, 0.99), 7.0);
+  EXPECT_DOUBLE_EQ(Percentile({1.0, 3.0}, 0.5), 2.0);
+  EXPECT_DOUBLE_EQ(Percentile({1.0, 3.0}, 2.0), 3.0);
+}
+
+// Advances a fake clock by the next duration from a cyclic list on every Run()
+class FakeClockTask : public Task<int, int> {
+ public:
+  FakeClockTask(double *clock, std::vector<double> durations) : clock_(clock), durations_(std::move(durations)) {}
+  bool ValidationImpl() override {
+    return true;
+  }
+  bool PreProcessingImpl() override {
+    return true;
+  }
+  bool RunImpl() override {
+    *clock_ += durations_[run_count % durations_.size()];
+    run_count++;
+    return true;
+  }
+  bool PostProcessingImpl() override {
+    return true;
+  }
+  std::size_t run_count = 0;
+
+ private:
+  double *clock_;
+  std::vector<double> durations_;
+};
+
+TEST(PerfTest, WarmupIterationsAreNotTimed) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.num_warmup = 2;
+  attr.current_timer = [&clock]() { return clock; };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(task_ptr->run_count, 5U);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 3U);
+}
+
+TEST(PerfTest, AdaptiveStopsOnceMedianIsStable) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 4;
+  attr.adaptive = true;
+  attr.max_time_sec = 1000.0;
+  attr.current_timer = [&clock]() { return clock; };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 4U);
+  EXPECT_DOUBLE_EQ(perf.GetPerfResults().median_rel_ci, 0.0);
+}
+
+TEST(PerfTest, AdaptiveRespectsMaxRunning) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0, 3.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.adaptive = true;
+  attr.max_running = 20;
+  attr.max_time_sec = 1000.0;
+  attr.current_timer = [&clock]() { return clock; };
+
+  perf.TaskRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 20U);
+  EXPECT_GT(perf.GetPerfResults().median_rel_ci, attr.target_rel_ci);
+}
+
+TEST(PerfTest, AdaptiveRespectsTimeBudget) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0, 3.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.adaptive = true;
+  attr.max_time_sec = 10.0;
+  attr.current_timer = [&clock]() { return clock; };
+
+  perf.PipelineRun(attr);
+  // 1 + 3 + 1 + 3 + 1 + 3 = 12 >= 10
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 6U);
+}
+
+TEST(PerfTest, AdaptiveFollowsStopDecision) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 1;
+  attr.adaptive = true;
+  attr.max_time_sec = 1000.0;
+  attr.current_timer = [&clock]() { return clock; };
+  int decisions = 0;
+  attr.stop_decision = [&decisions](bool /*stop*/) { return ++decisions == 7; };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(perf.GetPerfResults().samples.size(), 7U);
+}
+
+TEST(PerfTest, MedianRelativeCIShrinksWithMoreSamples) {
+  std::vector<double> few = {1.0, 2.0, 3.0, 4.0, 5.0};
+  std::vector<double> many;
+  for (int i = 0; i < 200; i++) {
+    many.push_back(i % 2 == 0 ? 2.9 : 3.1);
+  }
+  std::ranges::sort(many);
+  EXPECT_DOUBLE_EQ(MedianRelativeCI(few), (5.0 - 1.0) / (2.0 * 3.0));
+  EXPECT_LT(MedianRelativeCI(many), 0.05);
+  EXPECT_DOUBLE_EQ(MedianRelativeCI({2.0}), 0.0);
+}
+
+TEST(PerfTest, HwCountersAreCollectedOrReportedUnavailable) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 2;
+  attr.hw_counters = true;
+  attr.current_timer = [&clock]() { return clock; };
+
+  EXPECT_NO_THROW(perf.PipelineRun(attr));
+  const auto res = perf.GetPerfResults();
+  ASSERT_TRUE(res.hw_counters.has_value());
+  bool all_available = true;
+  for (bool available : res.hw_counters->available) {
+    all_available = all_available && available;
+  }
+  EXPECT_EQ(all_available, res.hw_counters->status.empty());
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("hw_counters"));
+}
+
+TEST(PerfTest, HwCountersAreOffByDefault) {
+  auto task_ptr = std::make_shared<DummyTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  perf.PipelineRun(attr);
+  EXPECT_FALSE(perf.GetPerfResults().hw_counters.has_value());
+}
+
+TEST(PerfTest, FormatHwCountersMarksUnavailable) {
+  HwCounterValues values;
+  values.values[static_cast<std::size_t>(HwCounter::kCycles)] = 200;
+  values.values[static_cast<std::size_t>(HwCounter::kInstructions)] = 100;
+  values.available[static_cast<std::size_t>(HwCounter::kCycles)] = true;
+  values.available[static_cast<std::size_t>(HwCounter::kInstructions)] = true;
+  const auto str = FormatHwCounters(values);
+  EXPECT_NE(str.find("cycles=200"), std::string::npos);
+  EXPECT_NE(str.find("llc_misses=n/a"), std::string::npos);
+  EXPECT_NE(str.find("ipc=0.500"), std::string::npos);
+}
+
+TEST(PerfTest, SyncAndReduceHooksWrapMeasurement) {
+  double clock = 0.0;
+  auto task_ptr = std::make_shared<FakeClockTask>(&clock, std::vector<double>{1.0});
+  Perf<int, int> perf(task_ptr);
+
+  PerfAttr attr;
+  attr.num_running = 3;
+  attr.current_timer = [&clock]() { return clock; };
+  int sync_calls = 0;
+  attr.sync_start = [&sync_calls]() { sync_calls++; };
+  // Pretend a second process was twice as slow on every iteration
+  attr.reduce_results = [](PerfResults &results) {
+    for (auto &sample : results.samples) {
+      sample *= 2.0;
+    }
+    results.rank_times = RankTimes{.num_ranks = 2, .min_sec = 1.0, .max_sec = 2.0, .mean_sec = 1.5, .imbalance = 2.0 / 1.5};
+  };
+
+  perf.PipelineRun(attr);
+  EXPECT_EQ(sync_calls, 3);
+  const auto res = perf.GetPerfResults();
+  EXPECT_DOUBLE_EQ(res.median_sec, 2.0);
+  ASSERT_TRUE(res.rank_times.has_value());
+  EXPECT_EQ(res.rank_times->num_ranks, 2);
+  EXPECT_NEAR(res.rank_times->imbalance, 4.0 / 3.0, 1e-12);
+  EXPECT_NO_THROW(perf.PrintPerfStatistic("rank_times"));
+}
+
+TEST(PerfTest, ReportsMeanStageTimings) {
+  struct SleepyRunTask : Task<int, int> {
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+  auto task_ptr = std::make_shared<SleepyRunTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 2;
+
+  perf.PipelineRun(attr);
+  EXPECT_GE(perf.GetPerfResults().stage_timings.run_sec, 0.005);
+
+  perf.TaskRun(attr);
+  EXPECT_GE(perf.GetPerfResults().stage_timings.run_sec, 0.005);
+  EXPECT_GE(perf.GetPerfResults().stage_timings.preprocessing_sec, 0.0);
+}
+
+TEST(PerfTest, ReportsMemoryPerIteration) {
+  struct AllocatingTask : Task<int, int> {
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      std::vector<int> buffer(1024);
+      GetOutput() = static_cast<int>(buffer.size());
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+  auto task_ptr = std::make_shared<AllocatingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 3;
+  perf.PipelineRun(attr);
+
+  const auto &memory = perf.GetPerfResults().memory;
+  EXPECT_EQ(memory.allocation_hooks, ppc::util::AllocationHooksLinked());
+  if (memory.allocation_hooks) {
+    EXPECT_GE(memory.allocations_per_iteration, 1.0);
+    EXPECT_GE(memory.bytes_per_iteration, 1024.0 * sizeof(int));
+    EXPECT_EQ(memory.stage_allocations.run.count, 1U);
+  } else {
+    EXPECT_DOUBLE_EQ(memory.allocations_per_iteration, 0.0);
+    EXPECT_NE(FormatMemoryStats(memory).find("allocs_per_iter=n/a"), std::string::npos);
+  }
+#ifdef __linux__
+  EXPECT_GT(memory.peak_rss_bytes, 0U);
+#endif
+}
+
+TEST(PerfTest, ReportsPeakRssPerStage) {
+  static constexpr std::size_t kBytes = std::size_t{64} << 20;
+  struct TouchingTask : Task<int, int> {
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      std::vector<char> buffer(kBytes, static_cast<char>(GetInput() + 1));
+      GetOutput() = buffer[kBytes / 2];
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+  if (!ppc::util::ResetPeakRss()) {
+    GTEST_SKIP() << "/proc/self/clear_refs is not writable";
+  }
+  auto task_ptr = std::make_shared<TouchingTask>();
+  Perf<int, int> perf(task_ptr);
+  PerfAttr attr;
+  attr.num_running = 2;
+  perf.PipelineRun(attr);
+
+  // The buffer of Run() is freed before PostProcessing(), so only Run() reports it
+  const auto &memory = perf.GetPerfResults().memory;
+  EXPECT_GT(memory.stage_peak_rss.run, memory.stage_peak_rss.postprocessing + (kBytes / 2));
+  EXPECT_GE(memory.peak_rss_bytes, memory.stage_peak_rss.run);
+  EXPECT_EQ(task_ptr->GetStagePeakRss().run, task_ptr->GetStagePeakRss().Max());
+}
+
+TEST(RegressionTest, MannWhitneyDetectsShiftedSamples) {
+  const std::vector<double> base = {1.0, 1.1, 0.9, 1.05, 0.95, 1.02, 0.98, 1.01};
+  std::vector<double> slower;
+  for (double value : base) {
+    slower.push_back(value * 1.5);
+  }
+  EXPECT_DOUBLE_EQ(MannWhitneyPValue(base, base), 1.0);
+  EXPECT_LT(MannWhitneyPValue(base, slower), 0.01);
+  EXPECT_DOUBLE_EQ(MannWhitneyPValue({}, slower), 1.0);
+  EXPECT_DOUBLE_EQ(MannWhitneyPValue({2.0, 2.0}, {2.0, 2.0}), 1.0);
+}
+
+TEST(RegressionTest, ClassifiesAgainstBaseline) {
+  const std::vector<double> base = {1.0, 1.1, 0.9, 1.05, 0.95, 1.02, 0.98, 1.01};
+  std::vector<double> slower;
+  std::vector<double> slightly_slower;
+  for (double value : base) {
+    slower.push_back(value * 1.3);
+    slightly_slower.push_back(value * 1.05);
+  }
+
+  const auto fail = CompareWithBaseline(base, slower, 0.1);
+  EXPECT_EQ(fail.verdict, RegressionVerdict::kFail);
+  EXPECT_NEAR(fail.ratio, 1.3, 1e-9);
+  EXPECT_EQ(CompareWithBaseline(base, slightly_slower, 0.1).verdict, RegressionVerdict::kPass);
+  EXPECT_EQ(CompareWithBaseline(base, base, 0.0).verdict, RegressionVerdict::kPass);
+  // Too few samples to tell a 30% slowdown from noise
+  EXPECT_EQ(CompareWithBaseline({1.0, 2.0}, {1.3, 2.6}, 0.1).verdict, RegressionVerdict::kNoise);
+  EXPECT_EQ(GetStringVerdict(RegressionVerdict::kNoise), "noise");
+}
+
 TEST(PerfTest, PrintPerfStatisticThrowsOnNone) {
   {
     auto task_ptr = std::make_shared<DummyTask>();
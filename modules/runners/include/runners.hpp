@@ -5,9 +5,13 @@
 #include <memory>
 #include <utility>
 
+#include "util/include/mpi_profile.hpp"
+
 namespace ppc::runners {
 
 /// @brief GTest event listener that checks for unread MPI messages after each test.
+/// @details Synchronizes and probes the communicator the test ran on (see ppc::util::CommGroups), so groups that run
+/// tests concurrently do not wait for each other.
 /// @note Used to detect unexpected inter-process communication leftovers.
 class UnreadMessagesDetector : public ::testing::EmptyTestEventListener {
  public:
@@ -36,7 +40,25 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
   std::shared_ptr<::testing::TestEventListener> base_;
 };
 
+/// @brief GTest event listener that prints the MPI calls made during each test.
+/// @details Active only when the PMPI hooks are linked (USE_MPI_PROFILING). The first rank of the communicator the
+/// test ran on prints one line per pipeline stage and MPI operation with calls and bytes summed over its ranks and the
+/// time of the slowest rank.
+class MpiProfilePrinter : public ::testing::EmptyTestEventListener {
+ public:
+  /// @brief Records the MPI statistics at the start of the test.
+  void OnTestStart(const ::testing::TestInfo & /*test_info*/) override;
+  /// @brief Reduces the statistics of the test over all ranks and prints them on rank 0.
+  void OnTestEnd(const ::testing::TestInfo &test_info) override;
+
+ private:
+  ppc::util::MpiProfile start_;
+};
+
 /// @brief Initializes the testing environment (e.g., MPI, logging).
+/// @details Threads and ranks are bound to CPUs according to PPC_PIN, splitting each node between its ranks. With
+/// PPC_COMM_GROUPS > 1 the world is split into ppc::util::CommGroups that run functional tests concurrently.
+/// PPC_MPI_THREADS selects MPI_Init_thread with the given thread level; the run aborts if MPI provides less.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS or MPI error code if initialization/
@@ -44,6 +66,7 @@ class WorkerTestFailurePrinter : public ::testing::EmptyTestEventListener {
 int Init(int argc, char **argv);
 
 /// @brief Initializes the testing environment only for gtest.
+/// @details Threads are bound to CPUs according to PPC_PIN.
 /// @param argc Argument count.
 /// @param argv Argument vector.
 /// @return Exit code from RUN_ALL_TESTS.
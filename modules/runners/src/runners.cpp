@@ -3,7 +3,9 @@
 #include <gtest/gtest.h>
 #include <mpi.h>
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <exception>
@@ -14,22 +16,34 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "oneapi/tbb/global_control.h"
+#include "util/include/affinity.hpp"
+#include "util/include/comm_groups.hpp"
+#include "util/include/mpi_profile.hpp"
+#include "util/include/mpi_threads.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::runners {
 
 void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/) {
+  const MPI_Comm comm = ppc::util::CommGroups::GetTestComm();
+  ppc::util::CommGroups::SetTestComm(MPI_COMM_WORLD);
+  if (comm == MPI_COMM_NULL) {
+    // Another group ran the test; its ranks check their own queues
+    return;
+  }
+
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(comm);
 
   int flag = -1;
   MPI_Status status;
 
-  const int iprobe_res = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, &status);
+  const int iprobe_res = MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm, &flag, &status);
   if (iprobe_res != MPI_SUCCESS) {
     std::cerr << std::format("[  PROCESS {}  ] [  ERROR  ] MPI_Iprobe failed with code {}", rank, iprobe_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, iprobe_res);
@@ -44,7 +58,54 @@ void UnreadMessagesDetector::OnTestEnd(const ::testing::TestInfo & /*test_info*/
     MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
   }
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(comm);
+}
+
+void MpiProfilePrinter::OnTestStart(const ::testing::TestInfo & /*test_info*/) {
+  start_ = ppc::util::ReadMpiProfile();
+}
+
+void MpiProfilePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
+  const auto profile = ppc::util::ReadMpiProfile() - start_;
+  const MPI_Comm comm = ppc::util::CommGroups::GetTestComm();
+  if (comm == MPI_COMM_NULL) {
+    return;
+  }
+
+  constexpr std::size_t kEntries = ppc::util::kNumMpiStages * ppc::util::kNumMpiCalls;
+  std::array<std::uint64_t, 2 * kEntries> counts{};
+  std::array<double, kEntries> times{};
+  for (std::size_t stage = 0; stage < ppc::util::kNumMpiStages; stage++) {
+    for (std::size_t call = 0; call < ppc::util::kNumMpiCalls; call++) {
+      const std::size_t entry = (stage * ppc::util::kNumMpiCalls) + call;
+      counts[entry] = profile.stats[stage][call].calls;
+      counts[kEntries + entry] = profile.stats[stage][call].bytes;
+      times[entry] = profile.stats[stage][call].time_sec;
+    }
+  }
+
+  // The PMPI entry points keep the reduction itself out of the profile
+  int rank = -1;
+  PMPI_Comm_rank(comm, &rank);
+  std::array<std::uint64_t, 2 * kEntries> total_counts{};
+  std::array<double, kEntries> max_times{};
+  PMPI_Reduce(counts.data(), total_counts.data(), static_cast<int>(counts.size()), MPI_UINT64_T, MPI_SUM, 0, comm);
+  PMPI_Reduce(times.data(), max_times.data(), static_cast<int>(times.size()), MPI_DOUBLE, MPI_MAX, 0, comm);
+  if (rank != 0) {
+    return;
+  }
+
+  ppc::util::MpiProfile total;
+  for (std::size_t stage = 0; stage < ppc::util::kNumMpiStages; stage++) {
+    for (std::size_t call = 0; call < ppc::util::kNumMpiCalls; call++) {
+      const std::size_t entry = (stage * ppc::util::kNumMpiCalls) + call;
+      total.stats[stage][call] = {
+          .calls = total_counts[entry], .bytes = total_counts[kEntries + entry], .time_sec = max_times[entry]};
+    }
+  }
+  for (const auto &line : ppc::util::DescribeMpiProfile(total)) {
+    std::cout << std::format("[  MPI  ] {}.{}:{}", test_info.test_suite_name(), test_info.name(), line) << '\n';
+  }
 }
 
 void WorkerTestFailurePrinter::OnTestEnd(const ::testing::TestInfo &test_info) {
@@ -124,6 +185,30 @@ bool HasFlag(int argc, char **argv, std::string_view flag) {
   return false;
 }
 
+// Splits the CPUs of the node between its ranks and binds this rank's threads according to PPC_PIN
+std::unique_ptr<ppc::util::ThreadPinning> PinThreads(int rank, int local_rank, int local_size, MPI_Comm node_comm) {
+  const auto policy = ppc::util::ParsePinPolicy(ppc::util::GetPin());
+  std::vector<int> cpus = ppc::util::GetThreadAffinity();
+  if (node_comm != MPI_COMM_NULL) {
+    // A launcher that already binds every rank to its own CPUs leaves nothing to split
+    const std::array<int, 2> local = {cpus.empty() ? -1 : cpus.front(), static_cast<int>(cpus.size())};
+    std::array<int, 2> lowest{};
+    std::array<int, 2> highest{};
+    MPI_Allreduce(local.data(), lowest.data(), 2, MPI_INT, MPI_MIN, node_comm);
+    MPI_Allreduce(local.data(), highest.data(), 2, MPI_INT, MPI_MAX, node_comm);
+    if (lowest != highest) {
+      local_rank = 0;
+      local_size = 1;
+    }
+  }
+  auto pinning = std::make_unique<ppc::util::ThreadPinning>(
+      policy, ppc::util::SelectRankCpus(cpus, local_rank, local_size, policy), ppc::util::GetNumThreads());
+  if (policy != ppc::util::PinPolicy::kNone) {
+    std::cout << std::format("[  PIN  ] process {}: {}", rank, pinning->Describe()) << '\n';
+  }
+  return pinning;
+}
+
 int RunAllTestsSafely() {
   try {
     return RunAllTests();
@@ -140,33 +225,72 @@ int RunAllTestsSafely() {
 }  // namespace
 
 int Init(int argc, char **argv) {
-  const int init_res = MPI_Init(&argc, &argv);
+  int requested = MPI_THREAD_SINGLE;
+  try {
+    requested = ppc::util::ParseMpiThreadLevel(ppc::util::GetMpiThreads());
+  } catch (const std::invalid_argument &e) {
+    std::cerr << std::format("[  ERROR  ] {}", e.what()) << '\n';
+    return EXIT_FAILURE;
+  }
+
+  // Plain MPI_Init unless a task opted into threaded communication through PPC_MPI_THREADS
+  int provided = MPI_THREAD_SINGLE;
+  const int init_res =
+      requested == MPI_THREAD_SINGLE ? MPI_Init(&argc, &argv) : MPI_Init_thread(&argc, &argv, requested, &provided);
   if (init_res != MPI_SUCCESS) {
     std::cerr << std::format("[  ERROR  ] MPI_Init failed with code {}", init_res) << '\n';
     MPI_Abort(MPI_COMM_WORLD, init_res);
     return init_res;
   }
+  if (provided < requested) {
+    std::cerr << std::format("[  ERROR  ] MPI provides thread level {} but PPC_MPI_THREADS requests {}",
+                             ppc::util::GetStringMpiThreadLevel(provided), ppc::util::GetStringMpiThreadLevel(requested))
+              << '\n';
+    MPI_Abort(MPI_COMM_WORLD, EXIT_FAILURE);
+    return EXIT_FAILURE;
+  }
 
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
 
+  int rank = -1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm node_comm = MPI_COMM_NULL;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+  int local_rank = 0;
+  int local_size = 1;
+  MPI_Comm_rank(node_comm, &local_rank);
+  MPI_Comm_size(node_comm, &local_size);
+  const auto pinning = PinThreads(rank, local_rank, local_size, node_comm);
+  MPI_Comm_free(&node_comm);
+
   ::testing::InitGoogleTest(&argc, argv);
 
   // Synchronize GoogleTest internals across ranks to avoid divergence
   SyncGTestSeed();
   SyncGTestFilter();
 
+  ppc::util::CommGroups::Split(ppc::util::GetCommGroups());
+  if (ppc::util::CommGroups::GetCount() > 1 && rank == 0) {
+    std::cout << std::format("[  GROUPS  ] {} communicator groups run functional tests concurrently",
+                             ppc::util::CommGroups::GetCount())
+              << '\n';
+  }
+
   auto &listeners = ::testing::UnitTest::GetInstance()->listeners();
-  int rank = -1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   const bool print_workers = HasFlag(argc, argv, "--print-workers");
   if (rank != 0 && !print_workers) {
     auto *listener = listeners.Release(listeners.default_result_printer());
     listeners.Append(new WorkerTestFailurePrinter(std::shared_ptr<::testing::TestEventListener>(listener)));
   }
   listeners.Append(new UnreadMessagesDetector());
+  if (ppc::util::MpiProfilingLinked()) {
+    // Appended last so that its OnTestEnd runs before the barriers of UnreadMessagesDetector
+    listeners.Append(new MpiProfilePrinter());
+  }
 
   const int status = RunAllTestsSafely();
+  ppc::util::CommGroups::Free();
 
   const int finalize_res = MPI_Finalize();
   if (finalize_res != MPI_SUCCESS) {
@@ -181,6 +305,8 @@ int SimpleInit(int argc, char **argv) {
   // Limit the number of threads in TBB
   tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetNumThreads());
 
+  const auto pinning = PinThreads(0, 0, 1, MPI_COMM_NULL);
+
   testing::InitGoogleTest(&argc, argv);
   return RunAllTests();
 }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+/// @brief Fixed-size worker pool that drives several independent tasks through their pipelines concurrently.
+/// @details Each submitted task runs all four stages on one worker, so a task whose stage is blocked (for example in
+/// an MPI collective) does not keep other tasks from computing. MPI and ALL tasks communicate from a worker thread, so
+/// they need at least MPI_THREAD_SERIALIZED. Several MPI tasks may only be submitted at once when MPI is initialized
+/// with MPI_THREAD_MULTIPLE and each task communicates on its own communicator.
+class AsyncExecutor {
+ public:
+  /// @param num_workers Number of worker threads; 0 selects std::thread::hardware_concurrency().
+  explicit AsyncExecutor(std::size_t num_workers = 0);
+  /// @brief Waits for all queued tasks to finish and joins the workers.
+  ~AsyncExecutor();
+  AsyncExecutor(const AsyncExecutor &) = delete;
+  AsyncExecutor &operator=(const AsyncExecutor &) = delete;
+
+  /// @brief Queues the full pipeline of a task.
+  /// @param task Task to run; the executor keeps it alive until the pipeline finishes.
+  /// @return Future with the combined result of all stages; it rethrows exceptions thrown by a stage.
+  /// @throws std::runtime_error If the task is an MPI or ALL task and MPI provides less than MPI_THREAD_SERIALIZED.
+  template <typename InType, typename OutType>
+  std::future<bool> Submit(TaskPtr<InType, OutType> task) {
+    CheckMpiThreadLevel(task->GetDynamicTypeOfTask());
+    auto job = std::make_shared<std::packaged_task<bool()>>([task = std::move(task)] { return task->RunPipeline(); });
+    auto result = job->get_future();
+    Post([job] { (*job)(); });
+    return result;
+  }
+
+  /// @brief Queues the full pipeline of a task that runs on @p comm.
+  /// @details Sets the task's communicator before queueing it; only tasks satisfying UsesTaskComm honour it. Give
+  /// tasks that run at the same time distinct communicators, for example the groups of ppc::util::CommGroups or the
+  /// duplicates of ppc::util::ThreadComms.
+  template <typename InType, typename OutType>
+  std::future<bool> Submit(TaskPtr<InType, OutType> task, MPI_Comm comm) {
+    task->SetComm(comm);
+    return Submit<InType, OutType>(std::move(task));
+  }
+
+  /// @brief Queues an arbitrary job; it runs on the first free worker.
+  void Post(std::function<void()> job);
+
+  /// @brief Returns the number of worker threads.
+  [[nodiscard]] std::size_t GetNumWorkers() const {
+    return workers_.size();
+  }
+
+ private:
+  static void CheckMpiThreadLevel(TypeOfTask type_of_task);
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> queue_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+};
+
+}  // namespace ppc::task
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "task/include/task.hpp"
+
+namespace ppc::task {
+
+/// @brief Outputs and timing of one BatchExecutor::Run() call.
+/// @tparam OutType Output data type.
+template <typename OutType>
+struct BatchResults {
+  /// Outputs in the order of the inputs
+  std::vector<OutType> outputs;
+  /// Time from the start of Validation() to the end of PostProcessing() for every item, in seconds
+  std::vector<double> latencies_sec;
+  /// Number of items for which at least one stage returned false
+  std::size_t failed = 0;
+  /// Wall time of the whole batch in seconds
+  double total_sec = 0.0;
+  /// Items per second
+  double throughput = 0.0;
+  double latency_p50_sec = 0.0;
+  double latency_p90_sec = 0.0;
+  double latency_p99_sec = 0.0;
+  double latency_max_sec = 0.0;
+};
+
+/// @brief Runs a stream of inputs through the task pipeline with software pipelining.
+/// @details While Run() of item k executes on the calling thread, a helper thread finishes item k-1
+/// (PostProcessing) and prepares item k+1 (Validation and PreProcessing). Three task instances rotate through these
+/// roles and are reused with Task::Rebind(), so scratch buffers kept by a task survive across items. A reused task
+/// gets a copy of the output the factory's first task started with, so that initial output must not depend on the
+/// input.
+/// MPI and ALL tasks communicate inside their stages, and overlapping two stages would interleave collectives, so for
+/// them the executor falls back to running the items one after another on the calling thread.
+/// @tparam InType Input data type.
+/// @tparam OutType Output data type.
+template <typename InType, typename OutType>
+class BatchExecutor {
+ public:
+  using TaskFactory = std::function<TaskPtr<InType, OutType>(InType)>;
+
+  /// @param factory Creates a task for the given input, e.g. TaskGetter<TaskType, InType>.
+  /// @param overlap Overlap the stages of neighbouring items; ignored for MPI and ALL tasks.
+  explicit BatchExecutor(TaskFactory factory, bool overlap = true) : factory_(std::move(factory)), overlap_(overlap) {}
+
+  /// @brief Processes all inputs and returns their outputs together with throughput and latency statistics.
+  /// @throws Any exception thrown by the task stages.
+  BatchResults<OutType> Run(std::vector<InType> inputs) {
+    const std::size_t count = inputs.size();
+    BatchResults<OutType> results;
+    results.outputs.resize(count);
+    results.latencies_sec.resize(count);
+    items_.assign(count, Item{});
+    if (count == 0) {
+      return results;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    Prepare(inputs, 0);
+    const bool overlap = overlap_ && count > 1 && IsOverlappable(slots_[0]->GetDynamicTypeOfTask());
+    if (overlap) {
+      for (std::size_t i = 0; i < count; i++) {
+        auto side = std::async(std::launch::async, [&, i] {
+          if (i > 0) {
+            Finish(results, i - 1);
+          }
+          if (i + 1 < count) {
+            Prepare(inputs, i + 1);
+          }
+        });
+        Execute(i);
+        side.get();
+      }
+    } else {
+      for (std::size_t i = 0; i < count; i++) {
+        if (i > 0) {
+          Prepare(inputs, i);
+        }
+        Execute(i);
+        if (i + 1 < count) {
+          Finish(results, i);
+        }
+      }
+    }
+    Finish(results, count - 1);
+    results.total_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ComputeStatistics(results);
+    return results;
+  }
+
+ private:
+  static constexpr std::size_t kNumSlots = 3;
+
+  struct Item {
+    std::chrono::steady_clock::time_point start;
+    bool ok = true;
+  };
+
+  static bool IsOverlappable(TypeOfTask type_of_task) {
+    return type_of_task != TypeOfTask::kMPI && type_of_task != TypeOfTask::kALL;
+  }
+
+  void Prepare(std::vector<InType> &inputs, std::size_t index) {
+    auto &task = slots_[index % kNumSlots];
+    items_[index].start = std::chrono::steady_clock::now();
+    if (task) {
+      task->Rebind(std::move(inputs[index]), OutType(*initial_output_));
+    } else {
+      task = factory_(std::move(inputs[index]));
+      if (!initial_output_) {
+        initial_output_ = task->GetOutput();
+      }
+    }
+    items_[index].ok = task->Validation();
+    items_[index].ok = task->PreProcessing() && items_[index].ok;
+  }
+
+  void Execute(std::size_t index) {
+    items_[index].ok = slots_[index % kNumSlots]->Run() && items_[index].ok;
+  }
+
+  void Finish(BatchResults<OutType> &results, std::size_t index) {
+    auto &task = slots_[index % kNumSlots];
+    items_[index].ok = task->PostProcessing() && items_[index].ok;
+    results.latencies_sec[index] =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - items_[index].start).count();
+    results.outputs[index] = std::move(task->GetOutput());
+  }
+
+  void ComputeStatistics(BatchResults<OutType> &results) const {
+    results.failed = static_cast<std::size_t>(std::ranges::count_if(items_, [](const Item &item) { return !item.ok; }));
+    const auto count = results.latencies_sec.size();
+    results.throughput = results.total_sec > 0.0 ? static_cast<double>(count) / results.total_sec : 0.0;
+
+    auto sorted = results.latencies_sec;
+    std::ranges::sort(sorted);
+    auto nearest_rank = [&sorted](double q) {
+      const auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+      return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+    };
+    results.latency_p50_sec = nearest_rank(0.5);
+    results.latency_p90_sec = nearest_rank(0.9);
+    results.latency_p99_sec = nearest_rank(0.99);
+    results.latency_max_sec = sorted.back();
+  }
+
+  TaskFactory factory_;
+  bool overlap_;
+  std::array<TaskPtr<InType, OutType>, kNumSlots> slots_;
+  /// Output of the first task before its pipeline, handed to every rebound task
+  std::optional<OutType> initial_output_;
+  std::vector<Item> items_;
+};
+
+}  // namespace ppc::task
@@ -1,18 +1,24 @@
 #pragma once
 
+#include <mpi.h>
 #include <omp.h>
 
+#include <algorithm>
 #include <array>
-#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <util/include/affinity.hpp>
+#include <util/include/clock.hpp>
+#include <util/include/memory.hpp>
+#include <util/include/mpi_profile.hpp>
 #include <util/include/util.hpp>
 #include <utility>
 
@@ -98,6 +104,74 @@ inline std::string GetStringTaskType(TypeOfTask type_of_task, const std::string
 
 enum class StateOfTesting : uint8_t { kFunc, kPerf };
 
+/// @brief Satisfied by tasks that make every MPI call on Task::GetComm() instead of MPI_COMM_WORLD.
+/// @details Such a task declares `static constexpr bool kUsesTaskComm = true;`. Only these tasks can run on a
+/// sub-communicator, for example on one of the groups of ppc::util::CommGroups.
+template <typename TaskType>
+concept UsesTaskComm = requires {
+  requires TaskType::kUsesTaskComm;
+};
+
+/// @brief Wall-clock durations of the pipeline stages in seconds.
+struct StageTimings {
+  /// Duration of the last Validation() call
+  double validation_sec = 0.0;
+  /// Duration of the last PreProcessing() call
+  double preprocessing_sec = 0.0;
+  /// Duration of the last Run() call
+  double run_sec = 0.0;
+  /// Duration of the last PostProcessing() call
+  double postprocessing_sec = 0.0;
+
+  /// @brief Returns the sum of all stage durations.
+  [[nodiscard]] double Total() const {
+    return validation_sec + preprocessing_sec + run_sec + postprocessing_sec;
+  }
+};
+
+/// @brief Heap allocations made by each pipeline stage.
+/// @details All values stay zero unless the allocation hooks are linked (USE_ALLOC_HOOKS). Allocations of other threads
+/// running at the same time are attributed to the stage as well.
+struct StageAllocations {
+  /// Allocations of the last Validation() call
+  ppc::util::AllocationCounters validation;
+  /// Allocations of the last PreProcessing() call
+  ppc::util::AllocationCounters preprocessing;
+  /// Allocations of the last Run() call
+  ppc::util::AllocationCounters run;
+  /// Allocations of the last PostProcessing() call
+  ppc::util::AllocationCounters postprocessing;
+
+  /// @brief Returns the allocations of all stages together.
+  [[nodiscard]] ppc::util::AllocationCounters Total() const {
+    auto total = validation;
+    total += preprocessing;
+    total += run;
+    total += postprocessing;
+    return total;
+  }
+};
+
+/// @brief Peak resident set size of each pipeline stage in bytes.
+/// @details The process-wide high-water mark is reset with ppc::util::ResetPeakRss() before a stage and read after it,
+/// so stages of tasks running at the same time on other threads reset each other's mark. All values stay zero where
+/// the mark cannot be reset.
+struct StagePeakRss {
+  /// Peak of the last Validation() call
+  uint64_t validation = 0;
+  /// Peak of the last PreProcessing() call
+  uint64_t preprocessing = 0;
+  /// Peak of the last Run() call
+  uint64_t run = 0;
+  /// Peak of the last PostProcessing() call
+  uint64_t postprocessing = 0;
+
+  /// @brief Returns the largest peak of all stages.
+  [[nodiscard]] uint64_t Max() const {
+    return std::max({validation, preprocessing, run, postprocessing});
+  }
+};
+
 template <typename InType, typename OutType>
 /// @brief Base abstract class representing a generic task with a defined pipeline.
 /// @tparam InType Input data type.
@@ -107,13 +181,25 @@ class Task {
   /// @brief Validates input data and task attributes before execution.
   /// @return True if validation is successful.
   virtual bool Validation() final {
+    // The OpenMP pool of a previous task was paused in its destructor, so the first run binds the new team again
+    if (stage_ == PipelineStage::kNone && (type_of_task_ == TypeOfTask::kOMP || type_of_task_ == TypeOfTask::kALL)) {
+      ppc::util::PinOmpThreads();
+    }
     if (stage_ == PipelineStage::kNone || stage_ == PipelineStage::kDone) {
       stage_ = PipelineStage::kValidation;
     } else {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Validation should be called before preprocessing");
     }
-    return ValidationImpl();
+    const bool peak_rss_reset = ppc::util::ResetPeakRss();
+    const auto allocations = ppc::util::ReadAllocationCounters();
+    const ppc::util::ScopedMpiStage mpi_stage(ppc::util::MpiStage::kValidation);
+    const double start = ppc::util::Clock::Now();
+    const bool result = ValidationImpl();
+    stage_timings_.validation_sec = SecondsSince(start);
+    stage_allocations_.validation = ppc::util::ReadAllocationCounters() - allocations;
+    stage_peak_rss_.validation = peak_rss_reset ? ppc::util::GetPeakRssBytes() : 0;
+    return result;
   }
 
   /// @brief Performs preprocessing on the input data.
@@ -128,7 +214,15 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PreProcessingImpl();
+    const bool peak_rss_reset = ppc::util::ResetPeakRss();
+    const auto allocations = ppc::util::ReadAllocationCounters();
+    const ppc::util::ScopedMpiStage mpi_stage(ppc::util::MpiStage::kPreProcessing);
+    const double start = ppc::util::Clock::Now();
+    const bool result = PreProcessingImpl();
+    stage_timings_.preprocessing_sec = SecondsSince(start);
+    stage_allocations_.preprocessing = ppc::util::ReadAllocationCounters() - allocations;
+    stage_peak_rss_.preprocessing = peak_rss_reset ? ppc::util::GetPeakRssBytes() : 0;
+    return result;
   }
 
   /// @brief Executes the main logic of the task.
@@ -140,7 +234,15 @@ class Task {
       stage_ = PipelineStage::kException;
       throw std::runtime_error("Run should be called after preprocessing");
     }
-    return RunImpl();
+    const bool peak_rss_reset = ppc::util::ResetPeakRss();
+    const auto allocations = ppc::util::ReadAllocationCounters();
+    const ppc::util::ScopedMpiStage mpi_stage(ppc::util::MpiStage::kRun);
+    const double start = ppc::util::Clock::Now();
+    const bool result = RunImpl();
+    stage_timings_.run_sec = SecondsSince(start);
+    stage_allocations_.run = ppc::util::ReadAllocationCounters() - allocations;
+    stage_peak_rss_.run = peak_rss_reset ? ppc::util::GetPeakRssBytes() : 0;
+    return result;
   }
 
   /// @brief Performs postprocessing on the output data.
@@ -155,7 +257,94 @@ class Task {
     if (state_of_testing_ == StateOfTesting::kFunc) {
       InternalTimeTest();
     }
-    return PostProcessingImpl();
+    const bool peak_rss_reset = ppc::util::ResetPeakRss();
+    const auto allocations = ppc::util::ReadAllocationCounters();
+    const ppc::util::ScopedMpiStage mpi_stage(ppc::util::MpiStage::kPostProcessing);
+    const double start = ppc::util::Clock::Now();
+    const bool result = PostProcessingImpl();
+    stage_timings_.postprocessing_sec = SecondsSince(start);
+    stage_allocations_.postprocessing = ppc::util::ReadAllocationCounters() - allocations;
+    stage_peak_rss_.postprocessing = peak_rss_reset ? ppc::util::GetPeakRssBytes() : 0;
+    return result;
+  }
+
+  /// @brief Runs Validation, PreProcessing, Run and PostProcessing in order.
+  /// @details Every stage is called even if an earlier one returned false, so the stage machine always ends in kDone.
+  /// @return True if all stages succeeded.
+  bool RunPipeline() {
+    bool result = Validation();
+    result = PreProcessing() && result;
+    result = Run() && result;
+    result = PostProcessing() && result;
+    return result;
+  }
+
+  /// @brief Runs the whole pipeline on a separate thread.
+  /// @details The task must stay alive until the returned future is ready. Use AsyncExecutor to drive many tasks on a
+  /// bounded number of threads.
+  /// @return Future with the result of RunPipeline(); it rethrows exceptions thrown by a stage.
+  std::future<bool> RunAsync() {
+    return std::async(std::launch::async, [this] { return RunPipeline(); });
+  }
+
+  /// @brief Returns the task to its initial pipeline state so it can be driven with a new input.
+  /// @details Clears stage timings and calls ResetImpl(). Input, output and any buffers owned by the derived task are
+  /// kept, so scratch allocations and partition plans survive across inputs.
+  /// @throws std::runtime_error If called while a pipeline is in progress.
+  void Reset() {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("Reset should be called before validation or after postprocessing");
+    }
+    stage_ = PipelineStage::kNone;
+    stage_timings_ = StageTimings{};
+    stage_allocations_ = StageAllocations{};
+    stage_peak_rss_ = StagePeakRss{};
+    ResetImpl();
+  }
+
+  /// @brief Resets the task and replaces its input and output without constructing a new task.
+  /// @param in New input data, moved into the task.
+  /// @param out Initial output value expected by ValidationImpl().
+  /// @throws std::runtime_error If called while a pipeline is in progress.
+  void Rebind(InType &&in, OutType &&out = OutType{}) {
+    Reset();
+    input_ = std::move(in);
+    output_ = std::move(out);
+  }
+
+  /// @brief Returns the communicator the task runs on; MPI_COMM_WORLD unless SetComm() was called.
+  [[nodiscard]] MPI_Comm GetComm() const {
+    return comm_;
+  }
+
+  /// @brief Makes the task run on @p comm, e.g. a group of ranks that works next to other groups.
+  /// @details Only tasks satisfying UsesTaskComm honour it. The communicator must outlive the task's pipeline.
+  /// @throws std::runtime_error If called while a pipeline is in progress.
+  void SetComm(MPI_Comm comm) {
+    if (stage_ != PipelineStage::kNone && stage_ != PipelineStage::kDone) {
+      stage_ = PipelineStage::kException;
+      throw std::runtime_error("SetComm should be called before validation or after postprocessing");
+    }
+    comm_ = comm;
+  }
+
+  /// @brief Returns the durations of the most recent call of every pipeline stage.
+  /// @return Stage durations in seconds measured with ppc::util::Clock.
+  [[nodiscard]] const StageTimings &GetStageTimings() const {
+    return stage_timings_;
+  }
+
+  /// @brief Returns the heap allocations of the most recent call of every pipeline stage.
+  /// @return Allocation counts and bytes; zero unless the allocation hooks are linked.
+  [[nodiscard]] const StageAllocations &GetStageAllocations() const {
+    return stage_allocations_;
+  }
+
+  /// @brief Returns the peak resident set size of the most recent call of every pipeline stage.
+  /// @return Peaks in bytes; zero where the high-water mark cannot be reset.
+  [[nodiscard]] const StagePeakRss &GetStagePeakRss() const {
+    return stage_peak_rss_;
   }
 
   /// @brief Returns the current testing mode.
@@ -216,14 +405,11 @@ class Task {
   /// @throws std::runtime_error If execution exceeds the allowed time limit.
   virtual void InternalTimeTest() final {
     if (stage_ == PipelineStage::kPreProcessing) {
-      tmp_time_point_ = std::chrono::high_resolution_clock::now();
+      tmp_time_point_ = ppc::util::Clock::Now();
     }
 
     if (stage_ == PipelineStage::kDone) {
-      auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() -
-                                                                           tmp_time_point_)
-                          .count();
-      auto diff = static_cast<double>(duration) * 1e-9;
+      auto diff = ppc::util::Clock::Now() - tmp_time_point_;
 
       const auto max_time = ppc::util::GetTaskMaxTime();
       std::stringstream err_msg;
@@ -254,13 +440,24 @@ class Task {
   /// @return True if postprocessing is successful.
   virtual bool PostProcessingImpl() = 0;
 
+  /// @brief Optional hook called by Reset() and Rebind() to drop per-input state.
+  virtual void ResetImpl() {}
+
  private:
+  static double SecondsSince(double start) {
+    return ppc::util::Clock::Now() - start;
+  }
+
   InType input_{};
   OutType output_{};
   StateOfTesting state_of_testing_ = StateOfTesting::kFunc;
   TypeOfTask type_of_task_ = TypeOfTask::kUnknown;
   StatusOfTask status_of_task_ = StatusOfTask::kEnabled;
-  std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+  double tmp_time_point_ = 0.0;
+  StageTimings stage_timings_;
+  StageAllocations stage_allocations_;
+  StagePeakRss stage_peak_rss_;
   enum class PipelineStage : uint8_t {
     kNone,
     kValidation,
@@ -278,13 +475,16 @@ template <typename InType, typename OutType>
 using TaskPtr = std::shared_ptr<Task<InType, OutType>>;
 
 /// @brief Constructs and returns a shared pointer to a task with the given input.
+/// @details The input is taken by value and moved into the task constructor. A constructor that accepts `InType` by
+/// value and does `GetInput() = std::move(in)` therefore receives the data without a single copy, while constructors
+/// taking `const InType &` keep working and copy once as before.
 /// @tparam TaskType Type of the task to create.
 /// @tparam InType Type of the input.
 /// @param in Input to pass to the task constructor.
 /// @return Shared a pointer to the newly created task.
 template <typename TaskType, typename InType>
-std::shared_ptr<TaskType> TaskGetter(const InType &in) {
-  return std::make_shared<TaskType>(in);
+std::shared_ptr<TaskType> TaskGetter(InType in) {
+  return std::make_shared<TaskType>(std::move(in));
 }
 
 }  // namespace ppc::task
@@ -0,0 +1,76 @@
+#include "task/include/async_executor.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "task/include/task.hpp"
+#include "util/include/mpi_threads.hpp"
+
+namespace ppc::task {
+
+AsyncExecutor::AsyncExecutor(std::size_t num_workers) {
+  if (num_workers == 0) {
+    num_workers = std::max(1U, std::thread::hardware_concurrency());
+  }
+  workers_.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; i++) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+AsyncExecutor::~AsyncExecutor() {
+  {
+    const std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+void AsyncExecutor::Post(std::function<void()> job) {
+  {
+    const std::scoped_lock lock(mutex_);
+    queue_.push_back(std::move(job));
+  }
+  cv_.notify_one();
+}
+
+void AsyncExecutor::CheckMpiThreadLevel(TypeOfTask type_of_task) {
+  if (type_of_task != TypeOfTask::kMPI && type_of_task != TypeOfTask::kALL) {
+    return;
+  }
+  const int provided = ppc::util::GetProvidedMpiThreadLevel();
+  if (provided < MPI_THREAD_SERIALIZED) {
+    throw std::runtime_error(std::format("MPI tasks run on executor threads and need MPI_THREAD_SERIALIZED, MPI "
+                                         "provides {}; set PPC_MPI_THREADS=serialized or multiple",
+                                         ppc::util::GetStringMpiThreadLevel(provided)));
+  }
+}
+
+void AsyncExecutor::WorkerLoop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+      job = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    job();
+  }
+}
+
+}  // namespace ppc::task
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
 
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <filesystem>
+#include <future>
 #include <fstream>
 #include <libenvpp/env.hpp>
 #include <memory>
@@ -16,7 +18,13 @@
 #include <vector>
 
 #include "runners/include/runners.hpp"
+#include "task/include/async_executor.hpp"
+#include "task/include/batch_executor.hpp"
 #include "task/include/task.hpp"
+#include "util/include/comm_groups.hpp"
+#include "util/include/func_test_util.hpp"
+#include "util/include/mpi_profile.hpp"
+#include "util/include/mpi_threads.hpp"
 #include "util/include/util.hpp"
 
 using ppc::task::StatusOfTask;
@@ -76,6 +84,13 @@ class FakeSlowTask : public TestTask<InType, OutType> {
   }
 };
 
+template <typename InType, typename OutType>
+class CommAwareTask : public TestTask<InType, OutType> {
+ public:
+  static constexpr bool kUsesTaskComm = true;
+  using TestTask<InType, OutType>::TestTask;
+};
+
 }  // namespace ppc::test
 
 TEST(TaskTests, CheckInt32t) {
@@ -307,6 +322,371 @@ TEST(TaskTest, PostProcessingThrowsIfCalledBeforeRun) {
   EXPECT_THROW(task->PostProcessing(), std::runtime_error);
 }
 
+TEST(TaskTest, StageTimingsMeasureEveryStage) {
+  struct SleepyTask : Task<int, int> {
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      return true;
+    }
+    bool RunImpl() override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  } task;
+
+  EXPECT_DOUBLE_EQ(task.GetStageTimings().Total(), 0.0);
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+
+  const auto &timings = task.GetStageTimings();
+  EXPECT_GE(timings.validation_sec, 0.0);
+  EXPECT_GE(timings.preprocessing_sec, 0.02);
+  EXPECT_GE(timings.run_sec, 0.01);
+  EXPECT_GE(timings.postprocessing_sec, 0.0);
+  EXPECT_GE(timings.Total(), timings.preprocessing_sec + timings.run_sec);
+}
+
+TEST(TaskTest, TaskGetterMovesInputIntoTask) {
+  class MovingTask : public Task<std::vector<int>, int> {
+   public:
+    explicit MovingTask(std::vector<int> in) {
+      GetInput() = std::move(in);
+    }
+
+   protected:
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+
+  std::vector<int> in(1000, 1);
+  const int *data = in.data();
+  auto task = ppc::task::TaskGetter<MovingTask, std::vector<int>>(std::move(in));
+  EXPECT_EQ(task->GetInput().data(), data);
+  EXPECT_EQ(task->GetInput().size(), 1000U);
+  EXPECT_TRUE(task->Validation());
+  EXPECT_TRUE(task->PreProcessing());
+  EXPECT_TRUE(task->Run());
+  EXPECT_TRUE(task->PostProcessing());
+}
+
+TEST(TaskTest, RebindRunsPipelineWithNewInput) {
+  std::vector<int32_t> in(20, 1);
+  ppc::test::TestTask<std::vector<int32_t>, int32_t> test_task(in);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  ASSERT_EQ(static_cast<size_t>(test_task.GetOutput()), in.size());
+
+  test_task.Rebind(std::vector<int32_t>(5, 3));
+  EXPECT_EQ(test_task.GetOutput(), 0);
+  EXPECT_DOUBLE_EQ(test_task.GetStageTimings().Total(), 0.0);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+  EXPECT_EQ(test_task.GetOutput(), 15);
+}
+
+TEST(TaskTest, ResetCallsHookAndKeepsInput) {
+  class CountingTask : public Task<int, int> {
+   public:
+    int resets = 0;
+
+   protected:
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+    void ResetImpl() override {
+      resets++;
+    }
+  } task;
+
+  task.GetInput() = 7;
+  task.Reset();
+  task.Rebind(8);
+  EXPECT_EQ(task.resets, 2);
+  EXPECT_EQ(task.GetInput(), 8);
+  task.Validation();
+  task.PreProcessing();
+  task.Run();
+  task.PostProcessing();
+}
+
+TEST(TaskTest, ResetThrowsInsidePipeline) {
+  ppc::test::TestTask<std::vector<int32_t>, int32_t> task({1});
+  task.Validation();
+  EXPECT_THROW(task.Reset(), std::runtime_error);
+}
+
+TEST(TaskTest, SetCommIsRejectedInsidePipeline) {
+  ppc::test::TestTask<std::vector<int32_t>, int32_t> task({1});
+  EXPECT_EQ(task.GetComm(), MPI_COMM_WORLD);
+  task.SetComm(MPI_COMM_SELF);
+  EXPECT_EQ(task.GetComm(), MPI_COMM_SELF);
+  task.Validation();
+  EXPECT_THROW(task.SetComm(MPI_COMM_WORLD), std::runtime_error);
+}
+
+TEST(TaskTest, OnlyCommAwareTasksAreScheduledOnGroups) {
+  using CommAwareTask = ppc::test::CommAwareTask<std::vector<int32_t>, int32_t>;
+  static_assert(ppc::task::UsesTaskComm<CommAwareTask>);
+  static_assert(!ppc::task::UsesTaskComm<ppc::test::TestTask<std::vector<int32_t>, int32_t>>);
+
+  // Without a split every rank is its own single group and claims every test
+  ASSERT_EQ(ppc::util::CommGroups::GetCount(), 1);
+  EXPECT_TRUE(ppc::util::CommGroups::ClaimNextTest());
+  auto task = ppc::util::GetFuncTestTask<CommAwareTask>(std::vector<int32_t>{1, 2});
+  ASSERT_NE(task, nullptr);
+  EXPECT_EQ(task->GetComm(), MPI_COMM_WORLD);
+  EXPECT_TRUE(task->RunPipeline());
+}
+
+TEST(TaskTest, MpiCallsAreAttributedToTheirStage) {
+  class CommunicatingTask : public Task<int, int> {
+   protected:
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      ppc::util::detail::RecordMpiCall(ppc::util::MpiCall::kScatterv, 64, 0.0);
+      return true;
+    }
+    bool RunImpl() override {
+      ppc::util::detail::RecordMpiCall(ppc::util::MpiCall::kAllreduce, 16, 0.0);
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  } task;
+
+  const auto before = ppc::util::ReadMpiProfile();
+  ASSERT_TRUE(task.RunPipeline());
+  const auto profile = ppc::util::ReadMpiProfile() - before;
+  EXPECT_EQ(profile.At(ppc::util::MpiStage::kPreProcessing, ppc::util::MpiCall::kScatterv).bytes, 64U);
+  EXPECT_EQ(profile.At(ppc::util::MpiStage::kRun, ppc::util::MpiCall::kAllreduce).calls, 1U);
+  EXPECT_EQ(profile.At(ppc::util::MpiStage::kRun, ppc::util::MpiCall::kScatterv).calls, 0U);
+
+  ppc::util::detail::RecordMpiCall(ppc::util::MpiCall::kBarrier, 0, 0.0);
+  const auto outside = ppc::util::ReadMpiProfile() - before;
+  EXPECT_EQ(outside.At(ppc::util::MpiStage::kOther, ppc::util::MpiCall::kBarrier).calls, 1U);
+  const auto lines = ppc::util::DescribeMpiProfile(outside);
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines.front().rfind("other:MPI_Barrier:calls=1,bytes=0", 0), 0U);
+}
+
+TEST(TaskTest, MpiStageIsTrackedPerThread) {
+  const auto before = ppc::util::ReadMpiProfile();
+  {
+    const ppc::util::ScopedMpiStage stage(ppc::util::MpiStage::kRun);
+    std::thread other([] { ppc::util::detail::RecordMpiCall(ppc::util::MpiCall::kTest, 0, 0.0); });
+    other.join();
+    ppc::util::detail::RecordMpiCall(ppc::util::MpiCall::kTest, 0, 0.0);
+  }
+  const auto profile = ppc::util::ReadMpiProfile() - before;
+  EXPECT_EQ(profile.At(ppc::util::MpiStage::kOther, ppc::util::MpiCall::kTest).calls, 1U);
+  EXPECT_EQ(profile.At(ppc::util::MpiStage::kRun, ppc::util::MpiCall::kTest).calls, 1U);
+  EXPECT_EQ(ppc::util::GetMpiCallName(ppc::util::MpiCall::kWinSync), "MPI_Win_sync");
+}
+
+class BatchExecutorTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(BatchExecutorTest, ProducesOutputsInInputOrder) {
+  std::vector<std::vector<int32_t>> inputs;
+  for (int32_t i = 1; i <= 7; i++) {
+    inputs.emplace_back(static_cast<std::size_t>(i), i);
+  }
+  ppc::task::BatchExecutor<std::vector<int32_t>, int32_t> executor(
+      ppc::task::TaskGetter<ppc::test::TestTask<std::vector<int32_t>, int32_t>, std::vector<int32_t>>, GetParam());
+
+  const auto results = executor.Run(inputs);
+  ASSERT_EQ(results.outputs.size(), inputs.size());
+  for (std::size_t i = 0; i < inputs.size(); i++) {
+    EXPECT_EQ(results.outputs[i], static_cast<int32_t>((i + 1) * (i + 1)));
+  }
+  EXPECT_EQ(results.failed, 0U);
+  EXPECT_EQ(results.latencies_sec.size(), inputs.size());
+  EXPECT_GT(results.throughput, 0.0);
+  EXPECT_LE(results.latency_p50_sec, results.latency_p90_sec);
+  EXPECT_LE(results.latency_p90_sec, results.latency_p99_sec);
+  EXPECT_LE(results.latency_p99_sec, results.latency_max_sec);
+
+  const auto second = executor.Run({{5, 5}, {}});
+  EXPECT_EQ(second.outputs[0], 10);
+  EXPECT_EQ(second.failed, 1U);
+}
+
+TEST_P(BatchExecutorTest, RebindKeepsTheInitialOutput) {
+  // Validation expects the sentinel the constructor sets, which OutType{} would not match
+  class SentinelTask : public Task<int, int> {
+   public:
+    explicit SentinelTask(int in) {
+      GetInput() = in;
+      GetOutput() = -1;
+    }
+
+   protected:
+    bool ValidationImpl() override {
+      return GetOutput() == -1;
+    }
+    bool PreProcessingImpl() override {
+      return true;
+    }
+    bool RunImpl() override {
+      GetOutput() = GetInput() * 2;
+      return true;
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+  };
+
+  ppc::task::BatchExecutor<int, int> executor(ppc::task::TaskGetter<SentinelTask, int>, GetParam());
+  const auto results = executor.Run({1, 2, 3, 4, 5});
+  EXPECT_EQ(results.failed, 0U);
+  EXPECT_EQ(results.outputs, (std::vector<int>{2, 4, 6, 8, 10}));
+}
+
+INSTANTIATE_TEST_SUITE_P(BatchExecutorTests, BatchExecutorTest, ::testing::Values(true, false),
+                         [](const auto &info) { return info.param ? "overlap" : "serial"; });
+
+TEST(TaskTest, BatchExecutorOverlapHidesPreProcessing) {
+  using Clock = std::chrono::steady_clock;
+  struct Interval {
+    Clock::time_point start;
+    Clock::time_point end;
+  };
+  static std::vector<Interval> pre_processing;
+  static std::vector<Interval> run;
+
+  // The input is the item index, so every stage records its interval in its own slot
+  class SleepyTask : public Task<int, int> {
+   public:
+    explicit SleepyTask(int in) {
+      GetInput() = in;
+    }
+
+   protected:
+    bool ValidationImpl() override {
+      return true;
+    }
+    bool PreProcessingImpl() override {
+      return Sleep(pre_processing);
+    }
+    bool RunImpl() override {
+      GetOutput() = GetInput();
+      return Sleep(run);
+    }
+    bool PostProcessingImpl() override {
+      return true;
+    }
+
+   private:
+    bool Sleep(std::vector<Interval> &intervals) {
+      auto &interval = intervals[static_cast<std::size_t>(GetInput())];
+      interval.start = Clock::now();
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      interval.end = Clock::now();
+      return true;
+    }
+  };
+
+  constexpr int kItems = 6;
+  pre_processing.assign(kItems, Interval{});
+  run.assign(kItems, Interval{});
+  std::vector<int> inputs(kItems);
+  for (int i = 0; i < kItems; i++) {
+    inputs[static_cast<std::size_t>(i)] = i;
+  }
+  ppc::task::BatchExecutor<int, int> executor(ppc::task::TaskGetter<SleepyTask, int>);
+  const auto results = executor.Run(inputs);
+  EXPECT_EQ(results.failed, 0U);
+  // PreProcessing of item i + 1 runs while item i is in Run()
+  for (std::size_t i = 0; i + 1 < kItems; i++) {
+    EXPECT_LT(pre_processing[i + 1].start, run[i].end);
+    EXPECT_LT(run[i].start, pre_processing[i + 1].end);
+  }
+}
+
+TEST(TaskTest, RunAsyncCompletesPipeline) {
+  std::vector<int32_t> in(10, 2);
+  ppc::test::TestTask<std::vector<int32_t>, int32_t> task(in);
+  auto result = task.RunAsync();
+  EXPECT_TRUE(result.get());
+  EXPECT_EQ(task.GetOutput(), 20);
+}
+
+TEST(TaskTest, AsyncExecutorRunsIndependentTasksConcurrently) {
+  using SlowTask = ppc::test::FakeSlowTask<std::vector<int32_t>, int32_t>;
+  ppc::task::AsyncExecutor executor(4);
+  EXPECT_EQ(executor.GetNumWorkers(), 4U);
+
+  std::vector<std::shared_ptr<SlowTask>> tasks;
+  std::vector<std::future<bool>> results;
+  const auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 1; i <= 4; i++) {
+    tasks.push_back(std::make_shared<SlowTask>(std::vector<int32_t>(static_cast<std::size_t>(i), 1)));
+    tasks.back()->GetStateOfTesting() = ppc::task::StateOfTesting::kPerf;
+    results.push_back(executor.Submit<std::vector<int32_t>, int32_t>(tasks.back()));
+  }
+  for (auto &result : results) {
+    EXPECT_TRUE(result.get());
+  }
+  EXPECT_LT(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), 4.0);
+  for (std::size_t i = 0; i < tasks.size(); i++) {
+    EXPECT_EQ(tasks[i]->GetOutput(), static_cast<int32_t>(i + 1));
+  }
+}
+
+TEST(TaskTest, AsyncExecutorPropagatesStageExceptions) {
+  ppc::task::AsyncExecutor executor(1);
+  auto task = std::make_shared<ppc::test::TestTask<std::vector<int32_t>, int32_t>>(std::vector<int32_t>{1});
+  task->Validation();
+  auto result = executor.Submit<std::vector<int32_t>, int32_t>(task);
+  EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(TaskTest, AsyncExecutorRejectsMpiTasksWithoutThreadedMpi) {
+  if (ppc::util::GetProvidedMpiThreadLevel() >= MPI_THREAD_SERIALIZED) {
+    GTEST_SKIP() << "MPI provides a threaded level";
+  }
+  ppc::task::AsyncExecutor executor(1);
+  ppc::task::TaskPtr<std::vector<int32_t>, int32_t> task =
+      std::make_shared<ppc::test::TestTask<std::vector<int32_t>, int32_t>>(std::vector<int32_t>{1});
+  task->SetTypeOfTask(ppc::task::TypeOfTask::kMPI);
+  EXPECT_THROW(executor.Submit(task), std::runtime_error);
+  // The rejected task was not started and can still run on the calling thread
+  EXPECT_TRUE(task->RunPipeline());
+}
+
 int main(int argc, char **argv) {
   return ppc::runners::SimpleInit(argc, argv);
 }
@@ -0,0 +1,129 @@
+// Replacement global operator new/delete that count heap allocations for ppc::util::ReadAllocationCounters().
+// Linked into the test executables only when the project is configured with -D USE_ALLOC_HOOKS=ON.
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "util/include/memory.hpp"
+
+namespace {
+
+[[maybe_unused]] const bool kHooksRegistered = [] {
+  ppc::util::detail::MarkAllocationHooksLinked();
+  return true;
+}();
+
+void *Allocate(std::size_t size) {
+  ppc::util::detail::RecordAllocation(size);
+  if (size == 0) {
+    size = 1;
+  }
+  while (true) {
+    void *ptr = std::malloc(size);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void *AllocateAligned(std::size_t size, std::align_val_t alignment) {
+  ppc::util::detail::RecordAllocation(size);
+  const auto align = static_cast<std::size_t>(alignment);
+  // aligned_alloc requires the size to be a multiple of the alignment
+  const std::size_t padded = ((size + align - 1) / align) * align;
+  while (true) {
+#ifdef _WIN32
+    void *ptr = _aligned_malloc(padded == 0 ? align : padded, align);
+#else
+    void *ptr = std::aligned_alloc(align, padded == 0 ? align : padded);
+#endif
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void DeallocateAligned(void *ptr) noexcept {
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+}  // namespace
+
+void *operator new(std::size_t size) {
+  return Allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+  return Allocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t & /*tag*/) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete(void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  DeallocateAligned(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  DeallocateAligned(ptr);
+}
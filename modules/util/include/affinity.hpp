@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief How ranks and threads are bound to CPUs, selected with PPC_PIN.
+enum class PinPolicy : uint8_t {
+  /// No binding, the OS scheduler places and migrates threads freely
+  kNone,
+  /// Consecutive threads are bound to neighbouring CPUs, sharing caches
+  kCompact,
+  /// Threads are spread evenly over the CPUs of the rank, maximizing memory bandwidth
+  kScatter
+};
+
+/// @brief Parses "none", "compact" or "scatter".
+/// @throws std::invalid_argument for any other value.
+PinPolicy ParsePinPolicy(std::string_view value);
+std::string GetStringPinPolicy(PinPolicy policy);
+
+/// @brief Returns the CPUs the calling thread may run on in ascending order, or an empty list if unsupported.
+std::vector<int> GetThreadAffinity();
+
+/// @brief Restricts the calling thread to the given CPUs.
+/// @return false if the list is empty, binding is unsupported on this platform or the OS rejected the mask.
+bool SetThreadAffinity(const std::vector<int> &cpus);
+
+/// @brief Returns the disjoint share of @p cpus used by one of @p local_size ranks on the node.
+/// @details Compact hands out contiguous blocks, scatter deals the CPUs out round-robin. When there are fewer CPUs
+/// than ranks, ranks share CPUs round-robin.
+std::vector<int> SelectRankCpus(const std::vector<int> &cpus, int local_rank, int local_size, PinPolicy policy);
+
+/// @brief Returns the CPU of thread @p thread_index out of @p num_threads within the rank's CPUs, or -1 for kNone.
+int SelectThreadCpu(const std::vector<int> &rank_cpus, int thread_index, int num_threads, PinPolicy policy);
+
+/// @brief Formats CPU ids as ranges, e.g. "0-3,8,10-11".
+std::string FormatCpuList(const std::vector<int> &cpus);
+
+/// @brief Binds the process and its OpenMP, TBB and STL threads according to a PinPolicy.
+/// @details On construction the calling (main) thread is restricted to the rank's CPUs, so every thread it spawns
+/// later inherits a mask disjoint from the other ranks on the node. The OpenMP team of @p num_threads is then bound
+/// one thread per CPU, and TBB workers are bound by a task_scheduler_observer whenever they join the arena. The main
+/// thread itself keeps the whole rank mask because it is also OpenMP thread 0 and TBB slot 0. STL threads spawned by
+/// tasks call PinCurrentThread() to take their own CPU. Task::~Task pauses the OpenMP runtime, which discards the
+/// bound team, so OpenMP tasks call PinOmpThreads() before their first stage to bind the new team again. A nested
+/// ThreadPinning shadows the active one until it is destroyed; destruction reactivates the previous pinning but does
+/// not undo existing masks.
+class ThreadPinning {
+ public:
+  ThreadPinning(PinPolicy policy, std::vector<int> rank_cpus, int num_threads);
+  ~ThreadPinning();
+
+  ThreadPinning(const ThreadPinning &) = delete;
+  ThreadPinning &operator=(const ThreadPinning &) = delete;
+  ThreadPinning(ThreadPinning &&) = delete;
+  ThreadPinning &operator=(ThreadPinning &&) = delete;
+
+  [[nodiscard]] PinPolicy GetPolicy() const {
+    return policy_;
+  }
+  [[nodiscard]] const std::vector<int> &GetRankCpus() const {
+    return rank_cpus_;
+  }
+  /// @brief Returns the CPU thread @p thread_index should run on, or -1 if threads are not bound.
+  [[nodiscard]] int GetThreadCpu(int thread_index) const;
+
+  /// @brief Binds the threads of the current OpenMP team of num_threads threads, creating it if needed.
+  void PinOmpTeam();
+
+  /// @brief Returns the effective binding map, e.g.
+  /// "policy=compact cpus=0-3 omp=[0:0-3 1:1 2:2 3:3] tbb=[1:1 2:2 3:3] stl=[0:0 1:1 2:2 3:3]".
+  /// @details The OpenMP entries are read back from the threads after binding, so they show what the OS accepted.
+  [[nodiscard]] std::string Describe() const;
+
+ private:
+  class TbbObserver;
+
+  PinPolicy policy_;
+  std::vector<int> rank_cpus_;
+  int num_threads_;
+  mutable std::mutex omp_affinity_mutex_;
+  std::vector<std::vector<int>> omp_affinity_;
+  std::unique_ptr<TbbObserver> tbb_observer_;
+  ThreadPinning *previous_ = nullptr;
+};
+
+/// @brief Binds the OpenMP team under the active ThreadPinning; a no-op when no pinning is active or PPC_PIN=none.
+void PinOmpThreads();
+
+/// @brief Binds the calling thread to the CPU of @p thread_index under the active ThreadPinning.
+/// @details Intended for std::thread workers; a no-op when no pinning is active or PPC_PIN=none.
+void PinCurrentThread(int thread_index);
+
+}  // namespace ppc::util
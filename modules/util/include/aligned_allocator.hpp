@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace ppc::util {
+
+/// Alignment of AlignedAllocator by default, one cache line and the widest common SIMD register
+inline constexpr std::size_t kCacheLineSize = 64;
+/// Size of a transparent or hugetlbfs huge page on x86-64 and most AArch64 kernels
+inline constexpr std::size_t kHugePageSize = std::size_t{2} << 20U;
+
+/// @brief Returns whether large aligned allocations are backed by huge pages.
+/// @details Enabled per build with the USE_HUGE_PAGES CMake option, so both variants can be benchmarked.
+bool HugePagesEnabled();
+
+/// @brief Allocates @p bytes aligned to @p alignment, which must be a power of two not above kHugePageSize.
+/// @details With huge pages enabled, blocks of at least kHugePageSize are mapped directly, aligned to a huge page and
+/// advised with madvise(MADV_HUGEPAGE). If transparent huge pages are disabled the block is taken from the
+/// hugetlbfs pool (MAP_HUGETLB), and if that is empty regular pages are used. Smaller blocks, and all blocks
+/// without huge pages, come from aligned operator new.
+/// @throws std::bad_alloc if no memory is available.
+void *AllocateAligned(std::size_t bytes, std::size_t alignment);
+
+/// @brief Releases a block from AllocateAligned() with the same @p bytes and @p alignment.
+void DeallocateAligned(void *ptr, std::size_t bytes, std::size_t alignment) noexcept;
+
+/// @brief Allocator with cache-line (or wider) alignment and huge pages for large buffers.
+/// @details Drop-in allocator for the std::vector members of task inputs, see AlignedVector.
+template <typename T, std::size_t Alignment = kCacheLineSize>
+class AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+  static_assert(Alignment <= kHugePageSize, "Alignment must not exceed a huge page");
+
+ public:
+  using value_type = T;
+  static constexpr std::size_t kAlignment = std::max(Alignment, alignof(T));
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  AlignedAllocator(const AlignedAllocator<U, Alignment> & /*other*/) noexcept {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(AllocateAligned(n * sizeof(T), kAlignment));
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    DeallocateAligned(ptr, n * sizeof(T), kAlignment);
+  }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+}  // namespace ppc::util
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ppc::util {
+
+/// @brief Time source selected by Clock.
+enum class ClockSource : uint8_t {
+  /// Invariant time-stamp counter calibrated against std::chrono::steady_clock
+  kTsc,
+  /// std::chrono::steady_clock
+  kSteady
+};
+
+/// @brief Properties of the selected time source, measured once per process.
+struct ClockInfo {
+  ClockSource source = ClockSource::kSteady;
+  /// Smallest observed non-zero difference between two consecutive readings in seconds
+  double resolution_sec = 0.0;
+  /// Mean cost of one Clock::Now() call in seconds
+  double overhead_sec = 0.0;
+  /// Calibrated counter frequency, 0.0 for the steady clock
+  double tsc_hz = 0.0;
+};
+
+/// @brief Monotonic clock used for all performance and stage timings.
+/// @details On x86-64 with an invariant TSC the counter is read directly, which costs a few nanoseconds; it is
+/// calibrated against steady_clock on first use. Elsewhere, or with PPC_PERF_CLOCK=steady, steady_clock is used.
+/// Readings are comparable within a process only.
+class Clock {
+ public:
+  /// @brief Returns seconds since an arbitrary process-wide epoch.
+  static double Now();
+  /// @brief Returns the selected source with its resolution and overhead.
+  static const ClockInfo &GetInfo();
+};
+
+std::string GetStringClockSource(ClockSource source);
+
+}  // namespace ppc::util
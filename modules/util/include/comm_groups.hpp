@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mpi.h>
+
+namespace ppc::util {
+
+/// @brief Split of MPI_COMM_WORLD into groups of ranks that run functional tests at the same time.
+/// @details With PPC_COMM_GROUPS > 1 the runner splits the world into groups of consecutive ranks. Functional tests
+/// of tasks that make all MPI calls on Task::GetComm() are dealt to the groups round-robin and run on the group
+/// communicator; every other test still runs on the whole world. Without a split the world is one group.
+class CommGroups {
+ public:
+  /// @brief Splits MPI_COMM_WORLD into @p count groups. Collective over the world.
+  /// @details @p count is clamped to [1, world size]; groups differ in size by at most one rank.
+  static void Split(int count);
+  /// @brief Frees the group communicator. Must be called before MPI_Finalize.
+  static void Free();
+
+  [[nodiscard]] static int GetCount() {
+    return count_;
+  }
+  [[nodiscard]] static int GetIndex() {
+    return index_;
+  }
+  /// @brief Returns the communicator of this rank's group, MPI_COMM_WORLD without a split.
+  [[nodiscard]] static MPI_Comm GetComm() {
+    return comm_;
+  }
+
+  /// @brief Returns whether this rank's group runs the next group-scheduled test.
+  /// @details Every rank has to call this once for every such test, in the same order, which holds because all ranks
+  /// walk the same filtered and shuffled test list.
+  static bool ClaimNextTest();
+
+  /// @brief Returns the communicator the current test runs on: the group communicator for a claimed test,
+  /// MPI_COMM_NULL if another group runs it, and MPI_COMM_WORLD otherwise.
+  [[nodiscard]] static MPI_Comm GetTestComm() {
+    return test_comm_;
+  }
+  static void SetTestComm(MPI_Comm comm) {
+    test_comm_ = comm;
+  }
+
+ private:
+  inline static int count_ = 1;
+  inline static int index_ = 0;
+  inline static int next_test_ = 0;
+  inline static MPI_Comm comm_ = MPI_COMM_WORLD;
+  inline static MPI_Comm test_comm_ = MPI_COMM_WORLD;
+};
+
+}  // namespace ppc::util
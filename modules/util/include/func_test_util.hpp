@@ -8,12 +8,14 @@
 #include <cstddef>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "task/include/task.hpp"
+#include "util/include/comm_groups.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
@@ -94,6 +96,9 @@ class BaseRunFuncTests : public ::testing::TestWithParam<FuncTestParam<InType, O
   /// @brief Initializes task instance and runs it through the full pipeline.
   void InitializeAndRunTask(const FuncTestParam<InType, OutType, TestType> &test_param) {
     task_ = std::get<static_cast<std::size_t>(GTestParamIndex::kTaskGetter)>(test_param)(GetTestInputData());
+    if (!task_) {
+      GTEST_SKIP() << "Runs on another communicator group";
+    }
     ExecuteTaskPipeline();
   }
 
@@ -122,10 +127,30 @@ auto ExpandToValues(const Tuple &t) {
   return ExpandToValuesImpl(t, std::make_index_sequence<kN>{});
 }
 
+/// @brief Creates the task of a functional test.
+/// @details When the world is split into communicator groups, tasks satisfying ppc::task::UsesTaskComm are dealt to
+/// the groups and run on the group communicator; the ranks of the other groups get nullptr and skip the test.
+template <typename Task, typename InType>
+std::shared_ptr<Task> GetFuncTestTask(InType in) {
+  if constexpr (ppc::task::UsesTaskComm<Task>) {
+    if (CommGroups::GetCount() > 1) {
+      if (!CommGroups::ClaimNextTest()) {
+        CommGroups::SetTestComm(MPI_COMM_NULL);
+        return nullptr;
+      }
+      CommGroups::SetTestComm(CommGroups::GetComm());
+      auto task = ppc::task::TaskGetter<Task, InType>(std::move(in));
+      task->SetComm(CommGroups::GetComm());
+      return task;
+    }
+  }
+  return ppc::task::TaskGetter<Task, InType>(std::move(in));
+}
+
 template <typename Task, typename InType, typename SizesContainer, std::size_t... Is>
 auto GenTaskTuplesImpl(const SizesContainer &sizes, const std::string &settings_path,
                        std::index_sequence<Is...> /*unused*/) {
-  return std::make_tuple(std::make_tuple(ppc::task::TaskGetter<Task, InType>,
+  return std::make_tuple(std::make_tuple(GetFuncTestTask<Task, InType>,
                                          std::string(GetNamespace<Task>()) + "_" +
                                              ppc::task::GetStringTaskType(Task::GetStaticTypeOfTask(), settings_path),
                                          sizes[Is])...);
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::util {
+
+/// @brief Number and total size of heap allocations made through global operator new.
+struct AllocationCounters {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+
+  AllocationCounters operator-(const AllocationCounters &other) const {
+    return {.count = count - other.count, .bytes = bytes - other.bytes};
+  }
+  AllocationCounters &operator+=(const AllocationCounters &other) {
+    count += other.count;
+    bytes += other.bytes;
+    return *this;
+  }
+};
+
+/// @brief Returns whether the replacement operator new/delete are linked into the executable.
+/// @details The hooks are enabled with the USE_ALLOC_HOOKS CMake option. Without them all allocation counters stay 0.
+bool AllocationHooksLinked();
+
+/// @brief Returns the allocations made by the whole process so far.
+AllocationCounters ReadAllocationCounters();
+
+/// @brief Returns the peak resident set size of the process in bytes, or 0 if it cannot be queried.
+/// @details The peak covers the time since the last successful ResetPeakRss(), or since the start of the process.
+uint64_t GetPeakRssBytes();
+
+/// @brief Lowers the peak resident set size reported by GetPeakRssBytes() to the current one.
+/// @details Writes 5 to /proc/self/clear_refs, so the mark is shared by all threads of the process.
+/// @return False if the mark cannot be reset (non-Linux systems or a kernel without clear_refs).
+bool ResetPeakRss();
+
+/// @brief Returns the current resident set size of the process in bytes, or 0 if it cannot be queried.
+uint64_t GetCurrentRssBytes();
+
+namespace detail {
+
+/// @brief Called by the allocation hooks for every operator new.
+void RecordAllocation(std::size_t bytes) noexcept;
+
+/// @brief Called once by the allocation hooks during static initialization.
+void MarkAllocationHooksLinked() noexcept;
+
+}  // namespace detail
+
+}  // namespace ppc::util
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief MPI operations intercepted by the profiling hooks.
+/// @details The large-count variants (MPI_Send_c and so on) of MPI 4 are counted under their int-count operation.
+enum class MpiCall : uint8_t {
+  kSend,
+  kRecv,
+  kIsend,
+  kIrecv,
+  kSendrecv,
+  kProbe,
+  kWait,
+  kTest,
+  kWaitall,
+  kBarrier,
+  kBcast,
+  kIbcast,
+  kScatter,
+  kScatterv,
+  kGather,
+  kGatherv,
+  kAllgather,
+  kAllgatherv,
+  kIallgatherv,
+  kReduce,
+  kAllreduce,
+  kIallreduce,
+  kReduceScatter,
+  kScan,
+  kAlltoall,
+  kAlltoallv,
+  kWinCreate,
+  kWinAllocate,
+  kWinAllocateShared,
+  kWinSharedQuery,
+  kWinFree,
+  kWinFence,
+  kWinLock,
+  kWinUnlock,
+  kWinLockAll,
+  kWinUnlockAll,
+  kWinFlush,
+  kWinSync,
+  kCount
+};
+
+/// @brief Pipeline stage an MPI call is attributed to; kOther covers test fixtures and framework code.
+enum class MpiStage : uint8_t { kOther, kValidation, kPreProcessing, kRun, kPostProcessing, kCount };
+
+inline constexpr std::size_t kNumMpiCalls = static_cast<std::size_t>(MpiCall::kCount);
+inline constexpr std::size_t kNumMpiStages = static_cast<std::size_t>(MpiStage::kCount);
+
+/// @brief Accumulated cost of one MPI operation.
+struct MpiCallStats {
+  uint64_t calls = 0;
+  /// Payload described by the buffers this rank passed, sent plus received
+  uint64_t bytes = 0;
+  /// Wall time spent inside the calls
+  double time_sec = 0.0;
+
+  MpiCallStats operator-(const MpiCallStats &other) const {
+    return {.calls = calls - other.calls, .bytes = bytes - other.bytes, .time_sec = time_sec - other.time_sec};
+  }
+};
+
+/// @brief MPI call statistics of one rank per pipeline stage and operation.
+struct MpiProfile {
+  std::array<std::array<MpiCallStats, kNumMpiCalls>, kNumMpiStages> stats{};
+
+  [[nodiscard]] MpiCallStats &At(MpiStage stage, MpiCall call) {
+    return stats[static_cast<std::size_t>(stage)][static_cast<std::size_t>(call)];
+  }
+  [[nodiscard]] const MpiCallStats &At(MpiStage stage, MpiCall call) const {
+    return stats[static_cast<std::size_t>(stage)][static_cast<std::size_t>(call)];
+  }
+
+  MpiProfile operator-(const MpiProfile &other) const;
+};
+
+/// @brief Returns whether the PMPI hooks are linked into the executable.
+/// @details The hooks are enabled with the USE_MPI_PROFILING CMake option. Without them the profile stays empty.
+bool MpiProfilingLinked();
+
+/// @brief Returns the MPI calls this rank has made so far.
+MpiProfile ReadMpiProfile();
+
+std::string_view GetMpiCallName(MpiCall call);
+std::string_view GetMpiStageName(MpiStage stage);
+
+/// @brief Formats every stage and operation with at least one call, the most expensive first.
+/// @return Lines like "run:MPI_Bcast:calls=24,bytes=4096,time=1.234e-03".
+std::vector<std::string> DescribeMpiProfile(const MpiProfile &profile);
+
+/// @brief Attributes MPI calls of the calling thread to a pipeline stage for the lifetime of the object.
+/// @details The stage is tracked per thread, so tasks running on other threads keep their own stage. Calls made by
+/// worker threads a stage spawns (OpenMP, TBB, std::thread) count as kOther.
+class ScopedMpiStage {
+ public:
+  explicit ScopedMpiStage(MpiStage stage);
+  ~ScopedMpiStage();
+
+  ScopedMpiStage(const ScopedMpiStage &) = delete;
+  ScopedMpiStage &operator=(const ScopedMpiStage &) = delete;
+  ScopedMpiStage(ScopedMpiStage &&) = delete;
+  ScopedMpiStage &operator=(ScopedMpiStage &&) = delete;
+
+ private:
+  MpiStage previous_;
+};
+
+namespace detail {
+
+/// @brief Called by the PMPI hooks after every intercepted call.
+void RecordMpiCall(MpiCall call, uint64_t bytes, double time_sec) noexcept;
+
+/// @brief Called once by the PMPI hooks during static initialization.
+void MarkMpiProfilingLinked() noexcept;
+
+}  // namespace detail
+
+}  // namespace ppc::util
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::util {
+
+/// @brief Parses "single", "funneled", "serialized" or "multiple" into the matching MPI_THREAD_* level.
+/// @throws std::invalid_argument for any other value.
+int ParseMpiThreadLevel(std::string_view value);
+std::string GetStringMpiThreadLevel(int level);
+
+/// @brief Returns the thread support level MPI was initialized with, MPI_THREAD_SINGLE before MPI_Init.
+/// @details The runners request the level given by PPC_MPI_THREADS and abort if MPI provides less.
+int GetProvidedMpiThreadLevel();
+
+/// @brief One duplicate of a communicator per thread, so that threads can communicate concurrently.
+/// @details Collectives of different threads must not interleave on one communicator. With a private duplicate per
+/// thread, thread i of every rank only has to issue the same sequence of operations on Get(i) as thread i of the
+/// other ranks. Construction and destruction are collective over the base communicator and must happen on one thread.
+class ThreadComms {
+ public:
+  /// @throws std::runtime_error if MPI was not initialized with MPI_THREAD_MULTIPLE.
+  ThreadComms(MPI_Comm comm, int num_threads);
+  ~ThreadComms();
+
+  ThreadComms(const ThreadComms &) = delete;
+  ThreadComms &operator=(const ThreadComms &) = delete;
+  ThreadComms(ThreadComms &&) = delete;
+  ThreadComms &operator=(ThreadComms &&) = delete;
+
+  /// @brief Returns the communicator of thread @p thread_index.
+  [[nodiscard]] MPI_Comm Get(int thread_index) const {
+    return comms_[static_cast<std::size_t>(thread_index)];
+  }
+  [[nodiscard]] int GetNumThreads() const {
+    return static_cast<int>(comms_.size());
+  }
+
+ private:
+  std::vector<MPI_Comm> comms_;
+};
+
+}  // namespace ppc::util
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <omp.h>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "util/include/util.hpp"
+
+namespace ppc::util {
+
+/// @brief Returns the number of online NUMA nodes, 1 if the topology cannot be read.
+int GetNumaNodeCount();
+
+/// @brief Returns how many resident pages of [data, data + bytes) are placed on each NUMA node.
+/// @details Index i of the result is node i. Pages that were never touched are not counted. Returns an empty vector
+/// if the placement cannot be queried (non-Linux systems or kernels without move_pages).
+std::vector<std::size_t> GetPagePlacement(const void *data, std::size_t bytes);
+
+/// @brief Formats a page placement as "node0=<pages>,node1=<pages>", or "n/a" if it is empty.
+std::string FormatPagePlacement(const std::vector<std::size_t> &pages_per_node);
+
+/// @brief Returns the whole pages of [data, data + bytes) to the OS so the next write places them anew.
+/// @details The memory must be private anonymous memory such as heap storage; it reads as zero afterwards.
+/// Partial pages at either end are left untouched. A no-op where madvise is unavailable.
+void DiscardPages(void *data, std::size_t bytes);
+
+/// @brief Fills @p data with gen(i) in parallel so that every page is first touched by the thread that processes it.
+/// @details Pages are discarded first, so this works on a vector that was already value-initialized on one thread.
+/// The loop uses the static OpenMP schedule over ppc::util::GetNumThreads() threads, which matches the partition
+/// of a `parallel for schedule(static)` in a task. Combined with PPC_PIN every page lands on the NUMA node of the
+/// thread that later reads it.
+template <typename T, typename Generator>
+  requires std::is_trivially_copyable_v<T>
+void FirstTouchFill(std::span<T> data, Generator gen) {
+  DiscardPages(data.data(), data.size_bytes());
+  const auto size = static_cast<std::ptrdiff_t>(data.size());
+#pragma omp parallel for schedule(static) num_threads(ppc::util::GetNumThreads())
+  for (std::ptrdiff_t i = 0; i < size; i++) {
+    data[static_cast<std::size_t>(i)] = gen(static_cast<std::size_t>(i));
+  }
+}
+
+/// @brief Allocator that leaves elements default-initialized so their pages stay untouched until first written.
+/// @details std::allocator value-initializes, which zeroes every page on the allocating thread. Use it through
+/// FirstTouchVector together with FirstTouchFill or a parallel loop of the task.
+template <typename T>
+class FirstTouchAllocator : public std::allocator<T> {
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = FirstTouchAllocator<U>;
+  };
+
+  FirstTouchAllocator() noexcept = default;
+  // Allocators must convert implicitly between element types
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  FirstTouchAllocator(const FirstTouchAllocator<U> & /*other*/) noexcept {}
+
+  template <typename U>
+  void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+    ::new (static_cast<void *>(ptr)) U;
+  }
+  template <typename U, typename... Args>
+  void construct(U *ptr, Args &&...args) {
+    ::new (static_cast<void *>(ptr)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  bool operator==(const FirstTouchAllocator<U> & /*other*/) const noexcept {
+    return true;
+  }
+};
+
+template <typename T>
+using FirstTouchVector = std::vector<T, FirstTouchAllocator<T>>;
+
+/// @brief A buffer whose pages can be queried as one memory block.
+template <typename T>
+concept ContiguousTrivialRange = std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+                                 std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+/// @brief Sums the page placement of all contiguous buffers of a task input.
+/// @details Contiguous ranges of trivially copyable elements are queried, other ranges are walked element by
+/// element, tuples and variants are visited. Scalars are ignored.
+template <typename T>
+void AccumulatePagePlacement(const T &value, std::vector<std::size_t> &pages_per_node) {
+  if constexpr (ContiguousTrivialRange<T>) {
+    const auto placement =
+        GetPagePlacement(std::ranges::data(value), std::ranges::size(value) * sizeof(std::ranges::range_value_t<T>));
+    if (pages_per_node.size() < placement.size()) {
+      pages_per_node.resize(placement.size());
+    }
+    for (std::size_t node = 0; node < placement.size(); node++) {
+      pages_per_node[node] += placement[node];
+    }
+  } else if constexpr (std::ranges::range<T>) {
+    for (const auto &item : value) {
+      AccumulatePagePlacement(item, pages_per_node);
+    }
+  } else if constexpr (requires { std::variant_size<T>::value; }) {
+    std::visit([&](const auto &alternative) { AccumulatePagePlacement(alternative, pages_per_node); }, value);
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    std::apply([&](const auto &...items) { (AccumulatePagePlacement(items, pages_per_node), ...); }, value);
+  }
+}
+
+template <typename T>
+std::vector<std::size_t> GetInputPagePlacement(const T &value) {
+  std::vector<std::size_t> pages_per_node;
+  AccumulatePagePlacement(value, pages_per_node);
+  return pages_per_node;
+}
+
+}  // namespace ppc::util
@@ -2,26 +2,122 @@
 
 #include <gtest/gtest.h>
 #include <omp.h>
+#include <tbb/global_control.h>
 
-#include <chrono>
 #include <csignal>
 #include <cstddef>
 #include <functional>
+#include <iomanip>
+#include <iostream>
+#include <libenvpp/detail/environment.hpp>
+#include <optional>
+#include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
+#include <variant>
+#include <vector>
 
+#include "performance/include/hw_counters.hpp"
 #include "performance/include/performance.hpp"
+#include "performance/include/regression.hpp"
 #include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/numa.hpp"
 #include "util/include/util.hpp"
 
 namespace ppc::util {
 
-double GetTimeMPI();
 int GetMPIRank();
+/// @brief Makes every process follow the adaptive stop decision of rank 0.
+bool SyncStopDecisionMPI(bool stop);
+/// @brief Collects hardware counter values of every process on rank 0.
+/// @return Values indexed by rank on rank 0, empty on other ranks.
+std::vector<ppc::performance::HwCounterValues> GatherHwCountersMPI(const ppc::performance::HwCounterValues &local);
+int GetMPIWorldSize();
+/// @brief Blocks until all processes reach this point.
+void BarrierMPI();
+/// @brief Replaces every sample with its maximum over all processes and fills PerfResults::rank_times.
+void ReduceRankTimesMPI(ppc::performance::PerfResults &perf_results);
+/// @brief Sums the per-iteration allocations and takes the maximum peak RSS over all processes.
+void ReduceMemoryMPI(ppc::performance::PerfResults &perf_results);
+
+/// @brief Describes one performance case for the structured result sink.
+struct PerfRunInfo {
+  std::string test_name;
+  std::string task_namespace;
+  ppc::task::TypeOfTask type_of_task = ppc::task::TypeOfTask::kUnknown;
+  ppc::performance::PerfResults::TypeOfRunning mode = ppc::performance::PerfResults::TypeOfRunning::kNone;
+  std::size_t input_size = 0;
+};
+
+/// @brief Builds a JSON record with the results, samples and run metadata of a performance case.
+nlohmann::json MakePerfJsonRecord(const PerfRunInfo &info, const ppc::performance::PerfResults &perf_results);
+
+/// @brief Appends a record as a single line to a JSON Lines file.
+/// @throws std::runtime_error If the file cannot be opened.
+void AppendPerfJsonRecord(const std::string &path, const nlohmann::json &record);
+
+/// @brief Returns the baseline key of a case: task namespace, task type, mode, thread count and process count.
+std::string MakePerfBaselineKey(const PerfRunInfo &info);
+
+/// @brief Loads the baseline samples stored under key.
+/// @return Samples, or std::nullopt if the file or the key does not exist.
+/// @throws std::runtime_error If the file exists but cannot be parsed.
+std::optional<std::vector<double>> LoadPerfBaseline(const std::string &path, const std::string &key);
+
+/// @brief Stores the samples and median of perf_results under key, keeping the other entries of the file.
+/// @throws std::runtime_error If the file cannot be written.
+void StorePerfBaseline(const std::string &path, const std::string &key,
+                       const ppc::performance::PerfResults &perf_results);
+
+/// @brief Counts scalar elements of a task input: ranges are flattened, tuples and variants are visited.
+template <typename T>
+std::size_t CountInputElements(const T &value) {
+  if constexpr (std::ranges::sized_range<T>) {
+    if constexpr (std::ranges::sized_range<std::ranges::range_value_t<T>>) {
+      std::size_t total = 0;
+      for (const auto &item : value) {
+        total += CountInputElements(item);
+      }
+      return total;
+    } else {
+      return static_cast<std::size_t>(std::ranges::size(value));
+    }
+  } else if constexpr (requires { std::variant_size<T>::value; }) {
+    return std::visit([](const auto &alternative) { return CountInputElements(alternative); }, value);
+  } else if constexpr (requires { std::tuple_size<T>::value; }) {
+    return std::apply([](const auto &...items) { return (std::size_t{0} + ... + CountInputElements(items)); }, value);
+  } else {
+    return 1;
+  }
+}
+
+/// @brief Sets the thread count seen by OpenMP, TBB and ppc::util::GetNumThreads() for the lifetime of the object.
+/// @note TBB applies the most restrictive active limit, so values above the runner's limit have no effect on TBB.
+class ScopedNumThreads {
+ public:
+  explicit ScopedNumThreads(int num_threads)
+      : env_scope_("PPC_NUM_THREADS", std::to_string(num_threads)),
+        prev_omp_threads_(omp_get_max_threads()),
+        tbb_control_(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t>(num_threads)) {
+    omp_set_num_threads(num_threads);
+  }
+  ~ScopedNumThreads() {
+    omp_set_num_threads(prev_omp_threads_);
+  }
+  ScopedNumThreads(const ScopedNumThreads &) = delete;
+  ScopedNumThreads &operator=(const ScopedNumThreads &) = delete;
+
+ private:
+  env::detail::set_scoped_environment_variable env_scope_;
+  int prev_omp_threads_;
+  tbb::global_control tbb_control_;
+};
 
 template <typename InType, typename OutType>
 using PerfTestParam = std::tuple<std::function<ppc::task::TaskPtr<InType, OutType>(InType)>, std::string,
@@ -44,27 +140,38 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
   virtual bool CheckTestOutputData(OutType &output_data) = 0;
   /// @brief Supplies input data for performance testing.
   virtual InType GetTestInputData() = 0;
+  /// @brief Hands the input over to the task under test.
+  /// @details Defaults to a copy from GetTestInputData(). Override it with `return std::move(input_data_);` when
+  /// CheckTestOutputData() does not need the input, so large inputs exist only once, inside the task.
+  virtual InType TakeTestInputData() {
+    return GetTestInputData();
+  }
 
   virtual void SetPerfAttributes(ppc::performance::PerfAttr &perf_attrs) {
-    if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
-        task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL) {
-      const double t0 = GetTimeMPI();
-      perf_attrs.current_timer = [t0] { return GetTimeMPI() - t0; };
-    } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kOMP) {
-      const double t0 = omp_get_wtime();
-      perf_attrs.current_timer = [t0] { return omp_get_wtime() - t0; };
-    } else if (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSEQ ||
-               task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kSTL ||
-               task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kTBB) {
-      const auto t0 = std::chrono::high_resolution_clock::now();
-      perf_attrs.current_timer = [&] {
-        auto now = std::chrono::high_resolution_clock::now();
-        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - t0).count();
-        return static_cast<double>(ns) * 1e-9;
+    const auto type_of_task = task_->GetDynamicTypeOfTask();
+    if (type_of_task == ppc::task::TypeOfTask::kMPI || type_of_task == ppc::task::TypeOfTask::kALL) {
+      perf_attrs.sync_start = BarrierMPI;
+      perf_attrs.reduce_results = [](ppc::performance::PerfResults &perf_results) {
+        ReduceRankTimesMPI(perf_results);
+        ReduceMemoryMPI(perf_results);
       };
-    } else {
+    } else if (type_of_task != ppc::task::TypeOfTask::kOMP && type_of_task != ppc::task::TypeOfTask::kSEQ &&
+               type_of_task != ppc::task::TypeOfTask::kSTL && type_of_task != ppc::task::TypeOfTask::kTBB) {
       throw std::runtime_error("The task type is not supported for performance testing.");
     }
+    const double t0 = ppc::util::Clock::Now();
+    perf_attrs.current_timer = [t0] { return ppc::util::Clock::Now() - t0; };
+
+    perf_attrs.num_warmup = static_cast<uint64_t>(ppc::util::GetPerfWarmup());
+    perf_attrs.hw_counters = ppc::util::GetPerfHwCounters();
+    const double target_ci = ppc::util::GetPerfTargetCI();
+    if (target_ci > 0.0) {
+      perf_attrs.adaptive = true;
+      perf_attrs.target_rel_ci = target_ci;
+      if (type_of_task == ppc::task::TypeOfTask::kMPI || type_of_task == ppc::task::TypeOfTask::kALL) {
+        perf_attrs.stop_decision = SyncStopDecisionMPI;
+      }
+    }
   }
 
   void ExecuteTest(const PerfTestParam<InType, OutType> &perf_test_param) {
@@ -79,11 +186,54 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
 
     const auto test_env_scope = ppc::util::test::MakePerTestEnvForCurrentGTest(test_name);
 
-    task_ = task_getter(GetTestInputData());
+    task_ = task_getter(TakeTestInputData());
+    const std::size_t input_size = CountInputElements(task_->GetInput());
+    // Placement is only worth reporting when remote NUMA nodes exist
+    const auto input_placement =
+        GetNumaNodeCount() > 1 ? GetInputPagePlacement(task_->GetInput()) : std::vector<std::size_t>{};
     ppc::performance::Perf perf(task_);
     ppc::performance::PerfAttr perf_attr;
     SetPerfAttributes(perf_attr);
 
+    RunPerf(perf, perf_attr, mode);
+
+    const auto &perf_results = perf.GetPerfResults();
+    const auto json_path = ppc::util::GetPerfJsonPath();
+    std::vector<ppc::performance::HwCounterValues> rank_counters;
+    if (perf_results.hw_counters && (task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kMPI ||
+                                     task_->GetDynamicTypeOfTask() == ppc::task::TypeOfTask::kALL)) {
+      rank_counters = GatherHwCountersMPI(*perf_results.hw_counters);
+    }
+
+    if (GetMPIRank() == 0) {
+      perf.PrintPerfStatistic(test_name);
+      const auto type_test_name = ppc::performance::GetStringParamName(mode);
+      if (!input_placement.empty()) {
+        std::cout << test_name << ":" << type_test_name << ":numa:input:" << FormatPagePlacement(input_placement)
+                  << '\n';
+      }
+      for (std::size_t proc = 0; proc < rank_counters.size(); proc++) {
+        std::cout << test_name << ":" << type_test_name << ":counters:rank=" << proc << ":"
+                  << ppc::performance::FormatHwCounters(rank_counters[proc]) << '\n';
+      }
+      if (!json_path.empty()) {
+        AppendPerfJsonRecord(json_path, MakePerfJsonRecord(MakeRunInfo(test_name, mode, input_size), perf_results));
+      }
+      const auto baseline_path = ppc::util::GetPerfBaselinePath();
+      if (!baseline_path.empty()) {
+        CheckBaseline(baseline_path, MakeRunInfo(test_name, mode, input_size), perf_results);
+      }
+    }
+
+    ASSERT_TRUE(CheckTestOutputData(task_->GetOutput()));
+
+    if (ppc::util::GetPerfSweep() && IsThreadSweepable(task_->GetDynamicTypeOfTask())) {
+      RunThreadSweep(test_name, mode, input_size, perf_results);
+    }
+  }
+
+  static void RunPerf(ppc::performance::Perf<InType, OutType> &perf, const ppc::performance::PerfAttr &perf_attr,
+                      ppc::performance::PerfResults::TypeOfRunning mode) {
     if (mode == ppc::performance::PerfResults::TypeOfRunning::kPipeline) {
       perf.PipelineRun(perf_attr);
     } else if (mode == ppc::performance::PerfResults::TypeOfRunning::kTaskRun) {
@@ -93,13 +243,85 @@ class BaseRunPerfTests : public ::testing::TestWithParam<PerfTestParam<InType, O
       err_msg << '\n' << "The type of performance check for the task was not selected.\n";
       throw std::runtime_error(err_msg.str().c_str());
     }
+  }
 
-    if (GetMPIRank() == 0) {
-      perf.PrintPerfStatistic(test_name);
+  PerfRunInfo MakeRunInfo(const std::string &test_name, ppc::performance::PerfResults::TypeOfRunning mode,
+                          std::size_t input_size) const {
+    const auto &task_ref = *task_;
+    return PerfRunInfo{.test_name = test_name,
+                       .task_namespace = ppc::util::GetNamespace(typeid(task_ref)),
+                       .type_of_task = task_->GetDynamicTypeOfTask(),
+                       .mode = mode,
+                       .input_size = input_size};
+  }
+
+  /// @brief Compares the run with its baseline entry, or overwrites the entry in update mode.
+  static void CheckBaseline(const std::string &baseline_path, const PerfRunInfo &info,
+                            const ppc::performance::PerfResults &perf_results) {
+    const auto key = MakePerfBaselineKey(info);
+    const auto prefix = info.test_name + ":" + ppc::performance::GetStringParamName(info.mode) + ":baseline:";
+    if (ppc::util::GetPerfBaselineUpdate()) {
+      StorePerfBaseline(baseline_path, key, perf_results);
+      std::cout << prefix << "updated" << '\n';
+      return;
     }
+    const auto baseline = LoadPerfBaseline(baseline_path, key);
+    if (!baseline) {
+      std::cout << prefix << "missing" << '\n';
+      return;
+    }
+    const double tolerance = ppc::util::GetPerfTolerance();
+    const auto check = ppc::performance::CompareWithBaseline(*baseline, perf_results.samples, tolerance);
+    std::stringstream check_str;
+    check_str << "verdict=" << ppc::performance::GetStringVerdict(check.verdict) << std::fixed << std::setprecision(4)
+              << ",ratio=" << check.ratio << ",p_value=" << check.p_value << ",tolerance=" << tolerance;
+    std::cout << prefix << check_str.str() << '\n';
+    EXPECT_NE(check.verdict, ppc::performance::RegressionVerdict::kFail)
+        << "Performance regression against " << baseline_path << " (" << key << "): " << check_str.str();
+  }
 
-    OutType output_data = task_->GetOutput();
-    ASSERT_TRUE(CheckTestOutputData(output_data));
+  static bool IsThreadSweepable(ppc::task::TypeOfTask type_of_task) {
+    return type_of_task == ppc::task::TypeOfTask::kOMP || type_of_task == ppc::task::TypeOfTask::kTBB ||
+           type_of_task == ppc::task::TypeOfTask::kSTL || type_of_task == ppc::task::TypeOfTask::kALL;
+  }
+
+  /// @brief Re-runs the already prepared task with 1..PPC_NUM_THREADS threads and reports speedup and efficiency.
+  /// @details The run with PPC_NUM_THREADS threads is the regular measurement passed as @p max_threads_results, so it
+  /// is reported without running it again. The output of every extra run is checked like the regular one.
+  void RunThreadSweep(const std::string &test_name, ppc::performance::PerfResults::TypeOfRunning mode,
+                      std::size_t input_size, const ppc::performance::PerfResults &max_threads_results) {
+    const int max_threads = ppc::util::GetNumThreads();
+    const auto type_test_name = ppc::performance::GetStringParamName(mode);
+    const auto json_path = ppc::util::GetPerfJsonPath();
+    double base_time = max_threads_results.median_sec;
+    for (int num_threads = 1; num_threads <= max_threads; num_threads++) {
+      ppc::performance::PerfResults perf_results = max_threads_results;
+      if (num_threads < max_threads) {
+        const ScopedNumThreads threads_scope(num_threads);
+        ppc::performance::Perf perf(task_);
+        ppc::performance::PerfAttr perf_attr;
+        SetPerfAttributes(perf_attr);
+        RunPerf(perf, perf_attr, mode);
+        ASSERT_TRUE(CheckTestOutputData(task_->GetOutput())) << "Wrong output with " << num_threads << " threads";
+        perf_results = perf.GetPerfResults();
+      }
+      if (num_threads == 1) {
+        base_time = perf_results.median_sec;
+      }
+      const double speedup = perf_results.median_sec > 0.0 ? base_time / perf_results.median_sec : 0.0;
+      const double efficiency = speedup / static_cast<double>(num_threads);
+      if (GetMPIRank() != 0) {
+        continue;
+      }
+      std::cout << test_name << ":" << type_test_name << ":sweep:threads=" << num_threads << std::fixed
+                << std::setprecision(10) << ",median=" << perf_results.median_sec << std::setprecision(4)
+                << ",speedup=" << speedup << ",efficiency=" << efficiency << '\n';
+      if (!json_path.empty()) {
+        auto record = MakePerfJsonRecord(MakeRunInfo(test_name, mode, input_size), perf_results);
+        record["sweep"] = {{"threads", num_threads}, {"speedup", speedup}, {"efficiency", efficiency}};
+        AppendPerfJsonRecord(json_path, record);
+      }
+    }
   }
 
  private:
@@ -71,10 +71,22 @@ int GetNumThreads();
 int GetNumProc();
 double GetTaskMaxTime();
 double GetPerfMaxTime();
-
-template <typename T>
-std::string GetNamespace() {
-  std::string name = typeid(T).name();
+int GetPerfWarmup();
+double GetPerfTargetCI();
+bool GetPerfHwCounters();
+std::string GetPerfJsonPath();
+bool GetPerfSweep();
+std::string GetPerfBaselinePath();
+bool GetPerfBaselineUpdate();
+double GetPerfTolerance();
+std::string GetPerfClock();
+std::string GetPin();
+int GetCommGroups();
+std::string GetMpiThreads();
+
+/// @brief Returns the enclosing namespace of a type given its runtime type information.
+inline std::string GetNamespace(const std::type_info &type_info) {
+  std::string name = type_info.name();
 #ifdef __GNUC__
   int status = 0;
   std::unique_ptr<char, void (*)(void *)> demangled{abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status),
@@ -95,6 +107,11 @@ std::string GetNamespace() {
   return (pos != std::string::npos) ? name.substr(0, pos) : std::string{};
 }
 
+template <typename T>
+std::string GetNamespace() {
+  return GetNamespace(typeid(T));
+}
+
 inline std::shared_ptr<nlohmann::json> InitJSONPtr() {
   return std::make_shared<nlohmann::json>();
 }
@@ -0,0 +1,497 @@
+// PMPI interposition hooks that record call counts, bytes and time for ppc::util::ReadMpiProfile().
+// Linked into the test executables only when the project is configured with -D USE_MPI_PROFILING=ON.
+
+#include <mpi.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "util/include/clock.hpp"
+#include "util/include/mpi_profile.hpp"
+
+namespace {
+
+using ppc::util::MpiCall;
+
+[[maybe_unused]] const bool kHooksRegistered = [] {
+  ppc::util::detail::MarkMpiProfilingLinked();
+  return true;
+}();
+
+// Count is int, or MPI_Count for the large-count variants
+template <typename Count>
+uint64_t TypeBytes(Count count, MPI_Datatype type) {
+  if (count <= 0 || type == MPI_DATATYPE_NULL) {
+    return 0;
+  }
+  int size = 0;
+  PMPI_Type_size(type, &size);
+  return static_cast<uint64_t>(count) * static_cast<uint64_t>(size);
+}
+
+template <typename Count>
+uint64_t SumTypeBytes(const Count counts[], MPI_Datatype type, MPI_Comm comm) {
+  if (counts == nullptr) {
+    return 0;
+  }
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  uint64_t bytes = 0;
+  for (int i = 0; i < size; i++) {
+    bytes += TypeBytes(counts[i], type);
+  }
+  return bytes;
+}
+
+int CommSize(MPI_Comm comm) {
+  int size = 0;
+  PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+bool IsRoot(int root, MPI_Comm comm) {
+  int rank = -1;
+  PMPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+bool InPlace(const void *buffer) {
+  return buffer == MPI_IN_PLACE;
+}
+
+template <typename Function>
+int Profile(MpiCall call, uint64_t bytes, Function &&pmpi) {
+  const double start = ppc::util::Clock::Now();
+  const int result = std::forward<Function>(pmpi)();
+  ppc::util::detail::RecordMpiCall(call, bytes, ppc::util::Clock::Now() - start);
+  return result;
+}
+
+// Bytes actually received, which may be fewer than the posted count
+uint64_t ReceivedBytes(const MPI_Status *status, MPI_Datatype type) {
+#if MPI_VERSION >= 4
+  MPI_Count count = 0;
+  if (PMPI_Get_count_c(status, type, &count) != MPI_SUCCESS || count == MPI_UNDEFINED) {
+    return 0;
+  }
+#else
+  int count = 0;
+  if (PMPI_Get_count(status, type, &count) != MPI_SUCCESS || count == MPI_UNDEFINED) {
+    return 0;
+  }
+#endif
+  return TypeBytes(count, type);
+}
+
+}  // namespace
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Profile(MpiCall::kSend, TypeBytes(count, datatype),
+                 [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  MPI_Status local_status;
+  MPI_Status *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  const double start = ppc::util::Clock::Now();
+  const int result = PMPI_Recv(buf, count, datatype, source, tag, comm, used_status);
+  const double elapsed = ppc::util::Clock::Now() - start;
+  ppc::util::detail::RecordMpiCall(MpiCall::kRecv, result == MPI_SUCCESS ? ReceivedBytes(used_status, datatype) : 0,
+                                   elapsed);
+  return result;
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Profile(MpiCall::kIsend, TypeBytes(count, datatype),
+                 [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+  return Profile(MpiCall::kIrecv, TypeBytes(count, datatype),
+                 [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+}
+
+int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int dest, int sendtag, void *recvbuf,
+                 int recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiCall::kSendrecv, TypeBytes(sendcount, sendtype) + TypeBytes(recvcount, recvtype), [&] {
+    return PMPI_Sendrecv(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                         comm, status);
+  });
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+  return Profile(MpiCall::kProbe, 0, [&] { return PMPI_Probe(source, tag, comm, status); });
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+  return Profile(MpiCall::kWait, 0, [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
+  return Profile(MpiCall::kTest, 0, [&] { return PMPI_Test(request, flag, status); });
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[], MPI_Status *array_of_statuses) {
+  return Profile(MpiCall::kWaitall, 0, [&] { return PMPI_Waitall(count, array_of_requests, array_of_statuses); });
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+  return Profile(MpiCall::kBarrier, 0, [&] { return PMPI_Barrier(comm); });
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  return Profile(MpiCall::kBcast, TypeBytes(count, datatype),
+                 [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Ibcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request *request) {
+  return Profile(MpiCall::kIbcast, TypeBytes(count, datatype),
+                 [&] { return PMPI_Ibcast(buffer, count, datatype, root, comm, request); });
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root ? TypeBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm)) : 0) +
+                         (is_root && InPlace(recvbuf) ? 0 : TypeBytes(recvcount, recvtype));
+  return Profile(MpiCall::kScatter, bytes, [&] {
+    return PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[], MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root ? SumTypeBytes(sendcounts, sendtype, comm) : 0) +
+                         (is_root && InPlace(recvbuf) ? 0 : TypeBytes(recvcount, recvtype));
+  return Profile(MpiCall::kScatterv, bytes, [&] {
+    return PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+               MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root && InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (is_root ? TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)) : 0);
+  return Profile(MpiCall::kGather, bytes, [&] {
+    return PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                const int displs[], MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root && InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (is_root ? SumTypeBytes(recvcounts, recvtype, comm) : 0);
+  return Profile(MpiCall::kGatherv, bytes, [&] {
+    return PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+  });
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes = (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)));
+  return Profile(MpiCall::kAllgather, bytes, [&] {
+    return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kAllgatherv, bytes, [&] {
+    return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  });
+}
+
+int MPI_Iallgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                    const int displs[], MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kIallgatherv, bytes, [&] {
+    return PMPI_Iallgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm, request);
+  });
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+               MPI_Comm comm) {
+  const uint64_t bytes = TypeBytes(count, datatype) * (IsRoot(root, comm) ? 2 : 1);
+  return Profile(MpiCall::kReduce, bytes,
+                 [&] { return PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Profile(MpiCall::kAllreduce, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Iallreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request *request) {
+  return Profile(MpiCall::kIallreduce, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request); });
+}
+
+int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[], MPI_Datatype datatype, MPI_Op op,
+                       MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  const uint64_t bytes = SumTypeBytes(recvcounts, datatype, comm) + TypeBytes(recvcounts[rank], datatype);
+  return Profile(MpiCall::kReduceScatter, bytes,
+                 [&] { return PMPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype, op, comm); });
+}
+
+int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Profile(MpiCall::kScan, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Scan(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+  const auto size = static_cast<uint64_t>(CommSize(comm));
+  const uint64_t bytes =
+      ((InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + TypeBytes(recvcount, recvtype)) * size;
+  return Profile(MpiCall::kAlltoall, bytes, [&] {
+    return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : SumTypeBytes(sendcounts, sendtype, comm)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kAlltoallv, bytes, [&] {
+    return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+  });
+}
+
+int MPI_Win_create(void *base, MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm, MPI_Win *win) {
+  return Profile(MpiCall::kWinCreate, 0, [&] { return PMPI_Win_create(base, size, disp_unit, info, comm, win); });
+}
+
+int MPI_Win_allocate(MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm, void *baseptr, MPI_Win *win) {
+  return Profile(MpiCall::kWinAllocate, 0,
+                 [&] { return PMPI_Win_allocate(size, disp_unit, info, comm, baseptr, win); });
+}
+
+int MPI_Win_allocate_shared(MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm, void *baseptr,
+                            MPI_Win *win) {
+  return Profile(MpiCall::kWinAllocateShared, 0,
+                 [&] { return PMPI_Win_allocate_shared(size, disp_unit, info, comm, baseptr, win); });
+}
+
+int MPI_Win_shared_query(MPI_Win win, int rank, MPI_Aint *size, int *disp_unit, void *baseptr) {
+  return Profile(MpiCall::kWinSharedQuery, 0,
+                 [&] { return PMPI_Win_shared_query(win, rank, size, disp_unit, baseptr); });
+}
+
+int MPI_Win_free(MPI_Win *win) {
+  return Profile(MpiCall::kWinFree, 0, [&] { return PMPI_Win_free(win); });
+}
+
+int MPI_Win_fence(int assertion, MPI_Win win) {
+  return Profile(MpiCall::kWinFence, 0, [&] { return PMPI_Win_fence(assertion, win); });
+}
+
+int MPI_Win_lock(int lock_type, int rank, int assertion, MPI_Win win) {
+  return Profile(MpiCall::kWinLock, 0, [&] { return PMPI_Win_lock(lock_type, rank, assertion, win); });
+}
+
+int MPI_Win_unlock(int rank, MPI_Win win) {
+  return Profile(MpiCall::kWinUnlock, 0, [&] { return PMPI_Win_unlock(rank, win); });
+}
+
+int MPI_Win_lock_all(int assertion, MPI_Win win) {
+  return Profile(MpiCall::kWinLockAll, 0, [&] { return PMPI_Win_lock_all(assertion, win); });
+}
+
+int MPI_Win_unlock_all(MPI_Win win) {
+  return Profile(MpiCall::kWinUnlockAll, 0, [&] { return PMPI_Win_unlock_all(win); });
+}
+
+int MPI_Win_flush(int rank, MPI_Win win) {
+  return Profile(MpiCall::kWinFlush, 0, [&] { return PMPI_Win_flush(rank, win); });
+}
+
+int MPI_Win_sync(MPI_Win win) {
+  return Profile(MpiCall::kWinSync, 0, [&] { return PMPI_Win_sync(win); });
+}
+
+#if MPI_VERSION >= 4
+// Large-count variants, recorded under the operation of their int-count counterpart
+
+int MPI_Send_c(const void *buf, MPI_Count count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+  return Profile(MpiCall::kSend, TypeBytes(count, datatype),
+                 [&] { return PMPI_Send_c(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Recv_c(void *buf, MPI_Count count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+               MPI_Status *status) {
+  MPI_Status local_status;
+  MPI_Status *used_status = status == MPI_STATUS_IGNORE ? &local_status : status;
+  const double start = ppc::util::Clock::Now();
+  const int result = PMPI_Recv_c(buf, count, datatype, source, tag, comm, used_status);
+  const double elapsed = ppc::util::Clock::Now() - start;
+  ppc::util::detail::RecordMpiCall(MpiCall::kRecv, result == MPI_SUCCESS ? ReceivedBytes(used_status, datatype) : 0,
+                                   elapsed);
+  return result;
+}
+
+int MPI_Isend_c(const void *buf, MPI_Count count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                MPI_Request *request) {
+  return Profile(MpiCall::kIsend, TypeBytes(count, datatype),
+                 [&] { return PMPI_Isend_c(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Irecv_c(void *buf, MPI_Count count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                MPI_Request *request) {
+  return Profile(MpiCall::kIrecv, TypeBytes(count, datatype),
+                 [&] { return PMPI_Irecv_c(buf, count, datatype, source, tag, comm, request); });
+}
+
+int MPI_Sendrecv_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, int dest, int sendtag,
+                   void *recvbuf, MPI_Count recvcount, MPI_Datatype recvtype, int source, int recvtag, MPI_Comm comm,
+                   MPI_Status *status) {
+  return Profile(MpiCall::kSendrecv, TypeBytes(sendcount, sendtype) + TypeBytes(recvcount, recvtype), [&] {
+    return PMPI_Sendrecv_c(sendbuf, sendcount, sendtype, dest, sendtag, recvbuf, recvcount, recvtype, source, recvtag,
+                           comm, status);
+  });
+}
+
+int MPI_Bcast_c(void *buffer, MPI_Count count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+  return Profile(MpiCall::kBcast, TypeBytes(count, datatype),
+                 [&] { return PMPI_Bcast_c(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Ibcast_c(void *buffer, MPI_Count count, MPI_Datatype datatype, int root, MPI_Comm comm,
+                 MPI_Request *request) {
+  return Profile(MpiCall::kIbcast, TypeBytes(count, datatype),
+                 [&] { return PMPI_Ibcast_c(buffer, count, datatype, root, comm, request); });
+}
+
+int MPI_Scatter_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf, MPI_Count recvcount,
+                  MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root ? TypeBytes(sendcount, sendtype) * static_cast<uint64_t>(CommSize(comm)) : 0) +
+                         (is_root && InPlace(recvbuf) ? 0 : TypeBytes(recvcount, recvtype));
+  return Profile(MpiCall::kScatter, bytes, [&] {
+    return PMPI_Scatter_c(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Scatterv_c(const void *sendbuf, const MPI_Count sendcounts[], const MPI_Aint displs[], MPI_Datatype sendtype,
+                   void *recvbuf, MPI_Count recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root ? SumTypeBytes(sendcounts, sendtype, comm) : 0) +
+                         (is_root && InPlace(recvbuf) ? 0 : TypeBytes(recvcount, recvtype));
+  return Profile(MpiCall::kScatterv, bytes, [&] {
+    return PMPI_Scatterv_c(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gather_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf, MPI_Count recvcount,
+                 MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root && InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (is_root ? TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)) : 0);
+  return Profile(MpiCall::kGather, bytes, [&] {
+    return PMPI_Gather_c(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm);
+  });
+}
+
+int MPI_Gatherv_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf,
+                  const MPI_Count recvcounts[], const MPI_Aint displs[], MPI_Datatype recvtype, int root,
+                  MPI_Comm comm) {
+  const bool is_root = IsRoot(root, comm);
+  const uint64_t bytes = (is_root && InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (is_root ? SumTypeBytes(recvcounts, recvtype, comm) : 0);
+  return Profile(MpiCall::kGatherv, bytes, [&] {
+    return PMPI_Gatherv_c(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm);
+  });
+}
+
+int MPI_Allgather_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf,
+                    MPI_Count recvcount, MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes = (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) +
+                         (TypeBytes(recvcount, recvtype) * static_cast<uint64_t>(CommSize(comm)));
+  return Profile(MpiCall::kAllgather, bytes, [&] {
+    return PMPI_Allgather_c(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Allgatherv_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf,
+                     const MPI_Count recvcounts[], const MPI_Aint displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kAllgatherv, bytes, [&] {
+    return PMPI_Allgatherv_c(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  });
+}
+
+int MPI_Iallgatherv_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf,
+                      const MPI_Count recvcounts[], const MPI_Aint displs[], MPI_Datatype recvtype, MPI_Comm comm,
+                      MPI_Request *request) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kIallgatherv, bytes, [&] {
+    return PMPI_Iallgatherv_c(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm, request);
+  });
+}
+
+int MPI_Reduce_c(const void *sendbuf, void *recvbuf, MPI_Count count, MPI_Datatype datatype, MPI_Op op, int root,
+                 MPI_Comm comm) {
+  const uint64_t bytes = TypeBytes(count, datatype) * (IsRoot(root, comm) ? 2 : 1);
+  return Profile(MpiCall::kReduce, bytes,
+                 [&] { return PMPI_Reduce_c(sendbuf, recvbuf, count, datatype, op, root, comm); });
+}
+
+int MPI_Allreduce_c(const void *sendbuf, void *recvbuf, MPI_Count count, MPI_Datatype datatype, MPI_Op op,
+                    MPI_Comm comm) {
+  return Profile(MpiCall::kAllreduce, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Allreduce_c(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Iallreduce_c(const void *sendbuf, void *recvbuf, MPI_Count count, MPI_Datatype datatype, MPI_Op op,
+                     MPI_Comm comm, MPI_Request *request) {
+  return Profile(MpiCall::kIallreduce, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Iallreduce_c(sendbuf, recvbuf, count, datatype, op, comm, request); });
+}
+
+int MPI_Reduce_scatter_c(const void *sendbuf, void *recvbuf, const MPI_Count recvcounts[], MPI_Datatype datatype,
+                         MPI_Op op, MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  const uint64_t bytes = SumTypeBytes(recvcounts, datatype, comm) + TypeBytes(recvcounts[rank], datatype);
+  return Profile(MpiCall::kReduceScatter, bytes,
+                 [&] { return PMPI_Reduce_scatter_c(sendbuf, recvbuf, recvcounts, datatype, op, comm); });
+}
+
+int MPI_Scan_c(const void *sendbuf, void *recvbuf, MPI_Count count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+  return Profile(MpiCall::kScan, TypeBytes(count, datatype) * 2,
+                 [&] { return PMPI_Scan_c(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Alltoall_c(const void *sendbuf, MPI_Count sendcount, MPI_Datatype sendtype, void *recvbuf, MPI_Count recvcount,
+                   MPI_Datatype recvtype, MPI_Comm comm) {
+  const auto size = static_cast<uint64_t>(CommSize(comm));
+  const uint64_t bytes =
+      ((InPlace(sendbuf) ? 0 : TypeBytes(sendcount, sendtype)) + TypeBytes(recvcount, recvtype)) * size;
+  return Profile(MpiCall::kAlltoall, bytes, [&] {
+    return PMPI_Alltoall_c(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  });
+}
+
+int MPI_Alltoallv_c(const void *sendbuf, const MPI_Count sendcounts[], const MPI_Aint sdispls[], MPI_Datatype sendtype,
+                    void *recvbuf, const MPI_Count recvcounts[], const MPI_Aint rdispls[], MPI_Datatype recvtype,
+                    MPI_Comm comm) {
+  const uint64_t bytes =
+      (InPlace(sendbuf) ? 0 : SumTypeBytes(sendcounts, sendtype, comm)) + SumTypeBytes(recvcounts, recvtype, comm);
+  return Profile(MpiCall::kAlltoallv, bytes, [&] {
+    return PMPI_Alltoallv_c(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+  });
+}
+#endif
@@ -0,0 +1,258 @@
+#include "util/include/affinity.hpp"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "oneapi/tbb/task_arena.h"
+#include "oneapi/tbb/task_scheduler_observer.h"
+
+#ifdef __linux__
+#  include <sched.h>
+#endif
+
+namespace {
+
+std::atomic<ppc::util::ThreadPinning *> active_pinning{nullptr};
+
+}  // namespace
+
+namespace ppc::util {
+
+class ThreadPinning::TbbObserver : public tbb::task_scheduler_observer {
+ public:
+  explicit TbbObserver(const ThreadPinning &pinning) : pinning_(pinning) {
+    observe(true);
+  }
+  TbbObserver(const TbbObserver &) = delete;
+  TbbObserver &operator=(const TbbObserver &) = delete;
+  TbbObserver(TbbObserver &&) = delete;
+  TbbObserver &operator=(TbbObserver &&) = delete;
+  ~TbbObserver() override {
+    observe(false);
+  }
+
+  void on_scheduler_entry(bool is_worker) override {
+    // Slot 0 is usually the main thread, which keeps the whole rank mask. A pinning shadowed by a nested one leaves
+    // the workers to the active pinning.
+    if (!is_worker || active_pinning.load() != &pinning_) {
+      return;
+    }
+    const int cpu = pinning_.GetThreadCpu(tbb::this_task_arena::current_thread_index());
+    if (cpu >= 0) {
+      SetThreadAffinity({cpu});
+    }
+  }
+
+ private:
+  const ThreadPinning &pinning_;
+};
+
+}  // namespace ppc::util
+
+ppc::util::PinPolicy ppc::util::ParsePinPolicy(std::string_view value) {
+  if (value == "none") {
+    return PinPolicy::kNone;
+  }
+  if (value == "compact") {
+    return PinPolicy::kCompact;
+  }
+  if (value == "scatter") {
+    return PinPolicy::kScatter;
+  }
+  throw std::invalid_argument(std::format("Unknown pinning policy '{}', expected none, compact or scatter", value));
+}
+
+std::string ppc::util::GetStringPinPolicy(PinPolicy policy) {
+  if (policy == PinPolicy::kCompact) {
+    return "compact";
+  }
+  if (policy == PinPolicy::kScatter) {
+    return "scatter";
+  }
+  return "none";
+}
+
+std::vector<int> ppc::util::GetThreadAffinity() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return cpus;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+#endif
+  return cpus;
+}
+
+bool ppc::util::SetThreadAffinity(const std::vector<int> &cpus) {
+  if (cpus.empty()) {
+    return false;
+  }
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &set);
+  }
+  // On Linux pid 0 addresses the calling thread, not the whole process
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+std::vector<int> ppc::util::SelectRankCpus(const std::vector<int> &cpus, int local_rank, int local_size,
+                                           PinPolicy policy) {
+  if (policy == PinPolicy::kNone || cpus.empty() || local_size <= 1) {
+    return cpus;
+  }
+  const auto size = cpus.size();
+  const auto ranks = static_cast<std::size_t>(local_size);
+  const auto rank = static_cast<std::size_t>(local_rank) % ranks;
+  if (size < ranks) {
+    return {cpus[rank % size]};
+  }
+  std::vector<int> selected;
+  if (policy == PinPolicy::kCompact) {
+    const std::size_t begin = rank * size / ranks;
+    const std::size_t end = (rank + 1) * size / ranks;
+    selected.assign(cpus.begin() + static_cast<std::ptrdiff_t>(begin), cpus.begin() + static_cast<std::ptrdiff_t>(end));
+  } else {
+    for (std::size_t i = rank; i < size; i += ranks) {
+      selected.push_back(cpus[i]);
+    }
+  }
+  return selected;
+}
+
+int ppc::util::SelectThreadCpu(const std::vector<int> &rank_cpus, int thread_index, int num_threads,
+                               PinPolicy policy) {
+  if (policy == PinPolicy::kNone || rank_cpus.empty() || thread_index < 0) {
+    return -1;
+  }
+  const auto size = rank_cpus.size();
+  const auto index = static_cast<std::size_t>(thread_index);
+  if (policy == PinPolicy::kScatter && num_threads > 0 && static_cast<std::size_t>(num_threads) < size) {
+    return rank_cpus[(index * size / static_cast<std::size_t>(num_threads)) % size];
+  }
+  return rank_cpus[index % size];
+}
+
+std::string ppc::util::FormatCpuList(const std::vector<int> &cpus) {
+  std::string result;
+  for (std::size_t i = 0; i < cpus.size();) {
+    std::size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      j++;
+    }
+    if (!result.empty()) {
+      result += ',';
+    }
+    result += j == i ? std::to_string(cpus[i]) : std::format("{}-{}", cpus[i], cpus[j]);
+    i = j + 1;
+  }
+  return result;
+}
+
+ppc::util::ThreadPinning::ThreadPinning(PinPolicy policy, std::vector<int> rank_cpus, int num_threads)
+    : policy_(rank_cpus.empty() ? PinPolicy::kNone : policy),
+      rank_cpus_(std::move(rank_cpus)),
+      num_threads_(std::max(1, num_threads)) {
+  if (policy_ == PinPolicy::kNone) {
+    return;
+  }
+  SetThreadAffinity(rank_cpus_);
+  PinOmpTeam();
+
+  tbb_observer_ = std::make_unique<TbbObserver>(*this);
+  previous_ = active_pinning.exchange(this);
+}
+
+ppc::util::ThreadPinning::~ThreadPinning() {
+  ThreadPinning *expected = this;
+  active_pinning.compare_exchange_strong(expected, previous_);
+}
+
+void ppc::util::ThreadPinning::PinOmpTeam() {
+  if (policy_ == PinPolicy::kNone) {
+    return;
+  }
+  std::vector<std::vector<int>> affinity(static_cast<std::size_t>(num_threads_));
+  // OpenMP reuses the threads of this team for later parallel regions of the same size or smaller until the pool is
+  // paused
+#pragma omp parallel num_threads(num_threads_)
+  {
+    const int thread = omp_get_thread_num();
+    if (thread != 0) {
+      SetThreadAffinity({GetThreadCpu(thread)});
+    }
+    affinity[static_cast<std::size_t>(thread)] = GetThreadAffinity();
+  }
+  const std::scoped_lock lock(omp_affinity_mutex_);
+  omp_affinity_ = std::move(affinity);
+}
+
+int ppc::util::ThreadPinning::GetThreadCpu(int thread_index) const {
+  return SelectThreadCpu(rank_cpus_, thread_index, num_threads_, policy_);
+}
+
+std::string ppc::util::ThreadPinning::Describe() const {
+  if (policy_ == PinPolicy::kNone) {
+    return std::format("policy=none cpus={}", FormatCpuList(GetThreadAffinity()));
+  }
+  std::string omp;
+  {
+    const std::scoped_lock lock(omp_affinity_mutex_);
+    for (std::size_t thread = 0; thread < omp_affinity_.size(); thread++) {
+      omp += std::format("{}{}:{}", thread == 0 ? "" : " ", thread, FormatCpuList(omp_affinity_[thread]));
+    }
+  }
+  // TBB workers occupy arena slots 1..n-1, STL workers pass their own index 0..n-1
+  std::string tbb;
+  std::string stl;
+  for (int thread = 0; thread < num_threads_; thread++) {
+    if (thread != 0) {
+      tbb += std::format("{}{}:{}", thread == 1 ? "" : " ", thread, GetThreadCpu(thread));
+    }
+    stl += std::format("{}{}:{}", thread == 0 ? "" : " ", thread, GetThreadCpu(thread));
+  }
+  return std::format("policy={} cpus={} omp=[{}] tbb=[{}] stl=[{}]", GetStringPinPolicy(policy_),
+                     FormatCpuList(rank_cpus_), omp, tbb, stl);
+}
+
+void ppc::util::PinOmpThreads() {
+  ThreadPinning *pinning = active_pinning.load();
+  if (pinning != nullptr) {
+    pinning->PinOmpTeam();
+  }
+}
+
+void ppc::util::PinCurrentThread(int thread_index) {
+  const ThreadPinning *pinning = active_pinning.load();
+  if (pinning == nullptr) {
+    return;
+  }
+  const int cpu = pinning->GetThreadCpu(thread_index);
+  if (cpu >= 0) {
+    SetThreadAffinity({cpu});
+  }
+}
@@ -0,0 +1,91 @@
+#include "util/include/aligned_allocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "util/include/memory.hpp"
+
+#if defined(PPC_USE_HUGE_PAGES) && defined(__linux__)
+#  define PPC_ALLOC_HUGE_PAGES 1
+#  include <sys/mman.h>
+#endif
+
+namespace {
+
+#ifdef PPC_ALLOC_HUGE_PAGES
+std::size_t RoundUpToHugePage(std::size_t bytes) {
+  return (bytes + ppc::util::kHugePageSize - 1) / ppc::util::kHugePageSize * ppc::util::kHugePageSize;
+}
+
+void *MapAnonymous(std::size_t length, int extra_flags) {
+  void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+void *MapHugePages(std::size_t length) {
+  // Over-map by one huge page and trim, so the block starts on a huge page boundary
+  auto *raw = static_cast<char *>(MapAnonymous(length + ppc::util::kHugePageSize, 0));
+  if (raw != nullptr) {
+    const auto address = reinterpret_cast<std::uintptr_t>(raw);
+    const std::size_t head = ((address + ppc::util::kHugePageSize - 1) & ~(ppc::util::kHugePageSize - 1)) - address;
+    char *aligned = raw + head;
+    if (head > 0) {
+      munmap(raw, head);
+    }
+    munmap(aligned + length, ppc::util::kHugePageSize - head);
+    if (madvise(aligned, length, MADV_HUGEPAGE) == 0) {
+      return aligned;
+    }
+    // Transparent huge pages are disabled, try the explicitly reserved pool instead
+    munmap(aligned, length);
+  }
+  void *ptr = MapAnonymous(length, MAP_HUGETLB);
+  if (ptr == nullptr) {
+    ptr = MapAnonymous(length, 0);
+  }
+  return ptr;
+}
+#endif
+
+}  // namespace
+
+bool ppc::util::HugePagesEnabled() {
+#ifdef PPC_ALLOC_HUGE_PAGES
+  return true;
+#else
+  return false;
+#endif
+}
+
+void *ppc::util::AllocateAligned(std::size_t bytes, std::size_t alignment) {
+#ifdef PPC_ALLOC_HUGE_PAGES
+  if (bytes >= kHugePageSize) {
+    void *ptr = MapHugePages(RoundUpToHugePage(bytes));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    // Mapped blocks bypass operator new, count them for the memory report anyway
+    if (AllocationHooksLinked()) {
+      detail::RecordAllocation(bytes);
+    }
+    return ptr;
+  }
+#endif
+  return ::operator new(bytes, std::align_val_t{alignment});
+}
+
+void ppc::util::DeallocateAligned(void *ptr, std::size_t bytes, std::size_t alignment) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+#ifdef PPC_ALLOC_HUGE_PAGES
+  if (bytes >= kHugePageSize) {
+    munmap(ptr, RoundUpToHugePage(bytes));
+    return;
+  }
+#else
+  (void)bytes;
+#endif
+  ::operator delete(ptr, std::align_val_t{alignment});
+}
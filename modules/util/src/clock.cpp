@@ -0,0 +1,139 @@
+#include "util/include/clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "util/include/util.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  define PPC_CLOCK_HAS_TSC 1
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#  endif
+#endif
+
+namespace ppc::util {
+
+namespace {
+
+struct ClockState {
+  ClockSource source = ClockSource::kSteady;
+  std::chrono::steady_clock::time_point steady_base;
+  uint64_t tsc_base = 0;
+  double seconds_per_tick = 0.0;
+  double tsc_hz = 0.0;
+};
+
+#ifdef PPC_CLOCK_HAS_TSC
+bool HasInvariantTsc() {
+  // CPUID.80000007H:EDX[8] advertises a TSC that runs at a constant rate in all power states
+  constexpr unsigned kInvariantTscBit = 1U << 8U;
+#  ifdef _MSC_VER
+  int regs[4] = {};
+  __cpuid(regs, static_cast<int>(0x80000000U));
+  if (static_cast<unsigned>(regs[0]) < 0x80000007U) {
+    return false;
+  }
+  __cpuid(regs, static_cast<int>(0x80000007U));
+  return (static_cast<unsigned>(regs[3]) & kInvariantTscBit) != 0;
+#  else
+  unsigned eax = 0;
+  unsigned ebx = 0;
+  unsigned ecx = 0;
+  unsigned edx = 0;
+  if (__get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  return (edx & kInvariantTscBit) != 0;
+#  endif
+}
+#endif
+
+ClockState MakeClockState() {
+  ClockState state;
+  state.steady_base = std::chrono::steady_clock::now();
+#ifdef PPC_CLOCK_HAS_TSC
+  if (GetPerfClock() != "steady" && HasInvariantTsc()) {
+    constexpr auto kCalibrationTime = std::chrono::milliseconds(20);
+    const auto steady_begin = std::chrono::steady_clock::now();
+    const uint64_t tsc_begin = __rdtsc();
+    auto steady_end = steady_begin;
+    while (steady_end - steady_begin < kCalibrationTime) {
+      steady_end = std::chrono::steady_clock::now();
+    }
+    const uint64_t tsc_end = __rdtsc();
+    const double elapsed = std::chrono::duration<double>(steady_end - steady_begin).count();
+    const double hz = static_cast<double>(tsc_end - tsc_begin) / elapsed;
+    if (hz > 0.0) {
+      state.source = ClockSource::kTsc;
+      state.tsc_hz = hz;
+      state.seconds_per_tick = 1.0 / hz;
+      state.tsc_base = __rdtsc();
+    }
+  }
+#endif
+  return state;
+}
+
+const ClockState &GetClockState() {
+  static const ClockState kState = MakeClockState();
+  return kState;
+}
+
+ClockInfo MeasureClockInfo() {
+  const auto &state = GetClockState();
+  ClockInfo info;
+  info.source = state.source;
+  info.tsc_hz = state.tsc_hz;
+
+  constexpr int kResolutionProbes = 1000;
+  double resolution = std::numeric_limits<double>::max();
+  for (int i = 0; i < kResolutionProbes; i++) {
+    const double first = Clock::Now();
+    double second = Clock::Now();
+    while (second == first) {
+      second = Clock::Now();
+    }
+    resolution = std::min(resolution, second - first);
+  }
+  info.resolution_sec = resolution;
+
+  constexpr int kOverheadCalls = 10000;
+  double sink = 0.0;
+  const double begin = Clock::Now();
+  for (int i = 0; i < kOverheadCalls; i++) {
+    sink += Clock::Now();
+  }
+  const double end = Clock::Now();
+  info.overhead_sec = sink >= 0.0 ? (end - begin) / kOverheadCalls : 0.0;
+  return info;
+}
+
+}  // namespace
+
+double Clock::Now() {
+  const auto &state = GetClockState();
+#ifdef PPC_CLOCK_HAS_TSC
+  if (state.source == ClockSource::kTsc) {
+    return static_cast<double>(__rdtsc() - state.tsc_base) * state.seconds_per_tick;
+  }
+#endif
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - state.steady_base).count();
+}
+
+const ClockInfo &Clock::GetInfo() {
+  static const ClockInfo kInfo = MeasureClockInfo();
+  return kInfo;
+}
+
+std::string GetStringClockSource(ClockSource source) {
+  return source == ClockSource::kTsc ? "tsc" : "steady";
+}
+
+}  // namespace ppc::util
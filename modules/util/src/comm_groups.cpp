@@ -0,0 +1,36 @@
+#include "util/include/comm_groups.hpp"
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstdint>
+
+void ppc::util::CommGroups::Split(int count) {
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  count_ = std::clamp(count, 1, size);
+  // Consecutive ranks usually share a node, so a group stays as local as the launcher placed it
+  index_ = static_cast<int>((static_cast<std::int64_t>(rank) * count_) / size);
+  next_test_ = 0;
+  if (count_ == 1) {
+    comm_ = MPI_COMM_WORLD;
+    return;
+  }
+  MPI_Comm_split(MPI_COMM_WORLD, index_, rank, &comm_);
+}
+
+void ppc::util::CommGroups::Free() {
+  if (comm_ != MPI_COMM_WORLD) {
+    MPI_Comm_free(&comm_);
+  }
+  comm_ = MPI_COMM_WORLD;
+  test_comm_ = MPI_COMM_WORLD;
+  count_ = 1;
+  index_ = 0;
+}
+
+bool ppc::util::CommGroups::ClaimNextTest() {
+  return (next_test_++ % count_) == index_;
+}
@@ -1,13 +1,108 @@
 #include <mpi.h>
 
-#include "util/include/perf_test_util.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
-double ppc::util::GetTimeMPI() {
-  return MPI_Wtime();
-}
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/performance.hpp"
+#include "util/include/perf_test_util.hpp"
 
 int ppc::util::GetMPIRank() {
   int rank = -1;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   return rank;
 }
+
+int ppc::util::GetMPIWorldSize() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    return 1;
+  }
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  return size;
+}
+
+bool ppc::util::SyncStopDecisionMPI(bool stop) {
+  int flag = stop ? 1 : 0;
+  MPI_Bcast(&flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return flag != 0;
+}
+
+std::vector<ppc::performance::HwCounterValues> ppc::util::GatherHwCountersMPI(
+    const ppc::performance::HwCounterValues &local) {
+  using ppc::performance::kNumHwCounters;
+  int rank = 0;
+  int size = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // Counter values followed by availability flags
+  constexpr std::size_t kStride = 2 * kNumHwCounters;
+  std::array<std::uint64_t, kStride> packed{};
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    packed[i] = local.values[i];
+    packed[kNumHwCounters + i] = local.available[i] ? 1 : 0;
+  }
+
+  std::vector<std::uint64_t> gathered(rank == 0 ? static_cast<std::size_t>(size) * kStride : 0);
+  MPI_Gather(packed.data(), static_cast<int>(kStride), MPI_UINT64_T, gathered.data(), static_cast<int>(kStride),
+             MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  std::vector<ppc::performance::HwCounterValues> result;
+  if (rank != 0) {
+    return result;
+  }
+  result.resize(static_cast<std::size_t>(size));
+  for (std::size_t proc = 0; proc < result.size(); proc++) {
+    for (std::size_t i = 0; i < kNumHwCounters; i++) {
+      result[proc].values[i] = gathered[(proc * kStride) + i];
+      result[proc].available[i] = gathered[(proc * kStride) + kNumHwCounters + i] != 0;
+    }
+  }
+  return result;
+}
+
+void ppc::util::BarrierMPI() {
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void ppc::util::ReduceRankTimesMPI(ppc::performance::PerfResults &perf_results) {
+  int size = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  auto &samples = perf_results.samples;
+  double local_sum = 0.0;
+  for (double sample : samples) {
+    local_sum += sample;
+  }
+  const double local_mean = samples.empty() ? 0.0 : local_sum / static_cast<double>(samples.size());
+
+  // Iterations start together, so an iteration lasts as long as its slowest process
+  MPI_Allreduce(MPI_IN_PLACE, samples.data(), static_cast<int>(samples.size()), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  ppc::performance::RankTimes rank_times;
+  rank_times.num_ranks = size;
+  MPI_Allreduce(&local_mean, &rank_times.min_sec, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(&local_mean, &rank_times.max_sec, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  double sum_of_means = 0.0;
+  MPI_Allreduce(&local_mean, &sum_of_means, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  rank_times.mean_sec = sum_of_means / static_cast<double>(size);
+  rank_times.imbalance = rank_times.mean_sec > 0.0 ? rank_times.max_sec / rank_times.mean_sec : 1.0;
+  perf_results.rank_times = rank_times;
+}
+
+void ppc::util::ReduceMemoryMPI(ppc::performance::PerfResults &perf_results) {
+  auto &memory = perf_results.memory;
+  std::array<double, 2> per_iteration = {memory.allocations_per_iteration, memory.bytes_per_iteration};
+  MPI_Allreduce(MPI_IN_PLACE, per_iteration.data(), static_cast<int>(per_iteration.size()), MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  memory.allocations_per_iteration = per_iteration[0];
+  memory.bytes_per_iteration = per_iteration[1];
+  std::uint64_t peak_rss = memory.peak_rss_bytes;
+  MPI_Allreduce(MPI_IN_PLACE, &peak_rss, 1, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+  memory.peak_rss_bytes = peak_rss;
+}
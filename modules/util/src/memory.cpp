@@ -0,0 +1,103 @@
+#include "util/include/memory.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef _WIN32
+#  include <sys/resource.h>
+#endif
+#ifdef __linux__
+#  include <fcntl.h>
+#  include <unistd.h>
+
+#  include <fstream>
+#  include <sstream>
+#  include <string>
+#  include <string_view>
+#endif
+
+namespace {
+
+std::atomic<uint64_t> allocation_count{0};
+std::atomic<uint64_t> allocation_bytes{0};
+std::atomic<bool> hooks_linked{false};
+
+#ifdef __linux__
+// Reads a "<field>: <value> kB" line of /proc/self/status
+uint64_t ReadProcStatusBytes(std::string_view field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.starts_with(field) && line.size() > field.size() && line[field.size()] == ':') {
+      std::istringstream fields(line.substr(field.size() + 1));
+      uint64_t kilobytes = 0;
+      fields >> kilobytes;
+      return kilobytes * 1024;
+    }
+  }
+  return 0;
+}
+#endif
+
+}  // namespace
+
+void ppc::util::detail::RecordAllocation(std::size_t bytes) noexcept {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ppc::util::detail::MarkAllocationHooksLinked() noexcept {
+  hooks_linked.store(true, std::memory_order_relaxed);
+}
+
+bool ppc::util::AllocationHooksLinked() {
+  return hooks_linked.load(std::memory_order_relaxed);
+}
+
+ppc::util::AllocationCounters ppc::util::ReadAllocationCounters() {
+  return {.count = allocation_count.load(std::memory_order_relaxed),
+          .bytes = allocation_bytes.load(std::memory_order_relaxed)};
+}
+
+uint64_t ppc::util::GetPeakRssBytes() {
+#ifdef _WIN32
+  return 0;
+#else
+#  ifdef __linux__
+  // VmHWM is updated together with VmRSS, ru_maxrss may lag behind it
+  const uint64_t high_water_mark = ReadProcStatusBytes("VmHWM");
+  if (high_water_mark > 0) {
+    return high_water_mark;
+  }
+#  endif
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#  ifdef __APPLE__
+  // macOS reports bytes, Linux reports kilobytes
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#  else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#  endif
+#endif
+}
+
+uint64_t ppc::util::GetCurrentRssBytes() {
+#ifdef __linux__
+  return ReadProcStatusBytes("VmRSS");
+#else
+  return 0;
+#endif
+}
+
+bool ppc::util::ResetPeakRss() {
+#ifdef __linux__
+  // Opened once, the reset itself is a single write
+  static const int kClearRefs = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+  return kClearRefs >= 0 && write(kClearRefs, "5", 1) == 1;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,120 @@
+#include "util/include/mpi_profile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct AtomicCallStats {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> time_ns{0};
+};
+
+std::array<std::array<AtomicCallStats, ppc::util::kNumMpiCalls>, ppc::util::kNumMpiStages> profile_stats;
+thread_local ppc::util::MpiStage current_stage = ppc::util::MpiStage::kOther;
+std::atomic<bool> profiling_linked{false};
+
+// Indexed by MpiCall
+constexpr std::array<std::string_view, ppc::util::kNumMpiCalls> kCallNames = {
+    "MPI_Send",           "MPI_Recv",       "MPI_Isend",          "MPI_Irecv",               "MPI_Sendrecv",
+    "MPI_Probe",          "MPI_Wait",       "MPI_Test",           "MPI_Waitall",             "MPI_Barrier",
+    "MPI_Bcast",          "MPI_Ibcast",     "MPI_Scatter",        "MPI_Scatterv",            "MPI_Gather",
+    "MPI_Gatherv",        "MPI_Allgather",  "MPI_Allgatherv",     "MPI_Iallgatherv",         "MPI_Reduce",
+    "MPI_Allreduce",      "MPI_Iallreduce", "MPI_Reduce_scatter", "MPI_Scan",                "MPI_Alltoall",
+    "MPI_Alltoallv",      "MPI_Win_create", "MPI_Win_allocate",   "MPI_Win_allocate_shared", "MPI_Win_shared_query",
+    "MPI_Win_free",       "MPI_Win_fence",  "MPI_Win_lock",       "MPI_Win_unlock",          "MPI_Win_lock_all",
+    "MPI_Win_unlock_all", "MPI_Win_flush",  "MPI_Win_sync"};
+
+constexpr std::array<std::string_view, ppc::util::kNumMpiStages> kStageNames = {
+    "other", "validation", "preprocessing", "run", "postprocessing"};
+
+}  // namespace
+
+ppc::util::MpiProfile ppc::util::MpiProfile::operator-(const MpiProfile &other) const {
+  MpiProfile result;
+  for (std::size_t stage = 0; stage < kNumMpiStages; stage++) {
+    for (std::size_t call = 0; call < kNumMpiCalls; call++) {
+      result.stats[stage][call] = stats[stage][call] - other.stats[stage][call];
+    }
+  }
+  return result;
+}
+
+bool ppc::util::MpiProfilingLinked() {
+  return profiling_linked.load(std::memory_order_relaxed);
+}
+
+ppc::util::MpiProfile ppc::util::ReadMpiProfile() {
+  MpiProfile profile;
+  for (std::size_t stage = 0; stage < kNumMpiStages; stage++) {
+    for (std::size_t call = 0; call < kNumMpiCalls; call++) {
+      const auto &source = profile_stats[stage][call];
+      auto &target = profile.stats[stage][call];
+      target.calls = source.calls.load(std::memory_order_relaxed);
+      target.bytes = source.bytes.load(std::memory_order_relaxed);
+      target.time_sec = static_cast<double>(source.time_ns.load(std::memory_order_relaxed)) * 1e-9;
+    }
+  }
+  return profile;
+}
+
+std::string_view ppc::util::GetMpiCallName(MpiCall call) {
+  return kCallNames[static_cast<std::size_t>(call)];
+}
+
+std::string_view ppc::util::GetMpiStageName(MpiStage stage) {
+  return kStageNames[static_cast<std::size_t>(stage)];
+}
+
+std::vector<std::string> ppc::util::DescribeMpiProfile(const MpiProfile &profile) {
+  std::vector<std::pair<MpiStage, MpiCall>> used;
+  for (std::size_t stage = 0; stage < kNumMpiStages; stage++) {
+    for (std::size_t call = 0; call < kNumMpiCalls; call++) {
+      if (profile.stats[stage][call].calls > 0) {
+        used.emplace_back(static_cast<MpiStage>(stage), static_cast<MpiCall>(call));
+      }
+    }
+  }
+  std::ranges::stable_sort(used, [&](const auto &lhs, const auto &rhs) {
+    return profile.At(lhs.first, lhs.second).time_sec > profile.At(rhs.first, rhs.second).time_sec;
+  });
+
+  std::vector<std::string> lines;
+  lines.reserve(used.size());
+  for (const auto &[stage, call] : used) {
+    const auto &stats = profile.At(stage, call);
+    std::stringstream line;
+    line << GetMpiStageName(stage) << ":" << GetMpiCallName(call) << ":calls=" << stats.calls
+         << ",bytes=" << stats.bytes << ",time=" << std::scientific << std::setprecision(3) << stats.time_sec;
+    lines.push_back(line.str());
+  }
+  return lines;
+}
+
+ppc::util::ScopedMpiStage::ScopedMpiStage(MpiStage stage) : previous_(std::exchange(current_stage, stage)) {}
+
+ppc::util::ScopedMpiStage::~ScopedMpiStage() {
+  current_stage = previous_;
+}
+
+void ppc::util::detail::RecordMpiCall(MpiCall call, uint64_t bytes, double time_sec) noexcept {
+  const auto stage = static_cast<std::size_t>(current_stage);
+  auto &stats = profile_stats[stage][static_cast<std::size_t>(call)];
+  stats.calls.fetch_add(1, std::memory_order_relaxed);
+  stats.bytes.fetch_add(bytes, std::memory_order_relaxed);
+  stats.time_ns.fetch_add(static_cast<uint64_t>(std::max(0.0, time_sec) * 1e9), std::memory_order_relaxed);
+}
+
+void ppc::util::detail::MarkMpiProfilingLinked() noexcept {
+  profiling_linked.store(true, std::memory_order_relaxed);
+}
@@ -0,0 +1,68 @@
+#include "util/include/mpi_threads.hpp"
+
+#include <mpi.h>
+
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+int ppc::util::ParseMpiThreadLevel(std::string_view value) {
+  if (value == "single") {
+    return MPI_THREAD_SINGLE;
+  }
+  if (value == "funneled") {
+    return MPI_THREAD_FUNNELED;
+  }
+  if (value == "serialized") {
+    return MPI_THREAD_SERIALIZED;
+  }
+  if (value == "multiple") {
+    return MPI_THREAD_MULTIPLE;
+  }
+  throw std::invalid_argument(
+      std::format("Unknown MPI thread level '{}', expected single, funneled, serialized or multiple", value));
+}
+
+std::string ppc::util::GetStringMpiThreadLevel(int level) {
+  if (level == MPI_THREAD_FUNNELED) {
+    return "funneled";
+  }
+  if (level == MPI_THREAD_SERIALIZED) {
+    return "serialized";
+  }
+  if (level == MPI_THREAD_MULTIPLE) {
+    return "multiple";
+  }
+  return "single";
+}
+
+int ppc::util::GetProvidedMpiThreadLevel() {
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (initialized == 0) {
+    return MPI_THREAD_SINGLE;
+  }
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided;
+}
+
+ppc::util::ThreadComms::ThreadComms(MPI_Comm comm, int num_threads) {
+  const int provided = GetProvidedMpiThreadLevel();
+  if (provided < MPI_THREAD_MULTIPLE) {
+    throw std::runtime_error(std::format("Per-thread communicators need MPI_THREAD_MULTIPLE, MPI provides {}; set "
+                                         "PPC_MPI_THREADS=multiple",
+                                         GetStringMpiThreadLevel(provided)));
+  }
+  comms_.resize(static_cast<std::size_t>(num_threads), MPI_COMM_NULL);
+  for (auto &thread_comm : comms_) {
+    MPI_Comm_dup(comm, &thread_comm);
+  }
+}
+
+ppc::util::ThreadComms::~ThreadComms() {
+  for (auto &thread_comm : comms_) {
+    MPI_Comm_free(&thread_comm);
+  }
+}
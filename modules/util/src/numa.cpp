@@ -0,0 +1,110 @@
+#include "util/include/numa.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef __linux__
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+std::size_t GetPageSize() {
+  static const auto kPageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return kPageSize;
+}
+#endif
+
+}  // namespace
+
+int ppc::util::GetNumaNodeCount() {
+  std::error_code ec;
+  int nodes = 0;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const auto name = entry.path().filename().string();
+    if (name.starts_with("node") && name.size() > 4 &&
+        std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+      nodes++;
+    }
+  }
+  return std::max(nodes, 1);
+}
+
+std::vector<std::size_t> ppc::util::GetPagePlacement(const void *data, std::size_t bytes) {
+  std::vector<std::size_t> pages_per_node;
+#if defined(__linux__) && defined(SYS_move_pages)
+  if (data == nullptr || bytes == 0) {
+    return pages_per_node;
+  }
+  const std::size_t page_size = GetPageSize();
+  const auto begin = reinterpret_cast<std::uintptr_t>(data) / page_size * page_size;
+  const auto end = reinterpret_cast<std::uintptr_t>(data) + bytes;
+
+  // move_pages with a null node list only reports the node of every page
+  constexpr std::size_t kBatch = 4096;
+  std::vector<void *> pages;
+  std::vector<int> status;
+  pages.reserve(kBatch);
+  for (std::uintptr_t page = begin; page < end;) {
+    pages.clear();
+    for (; page < end && pages.size() < kBatch; page += page_size) {
+      pages.push_back(reinterpret_cast<void *>(page));
+    }
+    status.assign(pages.size(), 0);
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), nullptr, status.data(), 0) != 0) {
+      return {};
+    }
+    for (int node : status) {
+      // Negative values are errors such as -ENOENT for pages that are not resident
+      if (node < 0) {
+        continue;
+      }
+      if (pages_per_node.size() <= static_cast<std::size_t>(node)) {
+        pages_per_node.resize(static_cast<std::size_t>(node) + 1);
+      }
+      pages_per_node[static_cast<std::size_t>(node)]++;
+    }
+  }
+#else
+  (void)data;
+  (void)bytes;
+#endif
+  return pages_per_node;
+}
+
+std::string ppc::util::FormatPagePlacement(const std::vector<std::size_t> &pages_per_node) {
+  if (pages_per_node.empty()) {
+    return "n/a";
+  }
+  std::string result;
+  for (std::size_t node = 0; node < pages_per_node.size(); node++) {
+    result += (node == 0 ? "node" : ",node") + std::to_string(node) + "=" + std::to_string(pages_per_node[node]);
+  }
+  return result;
+}
+
+void ppc::util::DiscardPages(void *data, std::size_t bytes) {
+#ifdef __linux__
+  if (data == nullptr) {
+    return;
+  }
+  const std::size_t page_size = GetPageSize();
+  const auto first = reinterpret_cast<std::uintptr_t>(data);
+  const std::uintptr_t begin = (first + page_size - 1) / page_size * page_size;
+  const std::uintptr_t end = (first + bytes) / page_size * page_size;
+  if (begin < end) {
+    madvise(reinterpret_cast<void *>(begin), end - begin, MADV_DONTNEED);
+  }
+#else
+  (void)data;
+  (void)bytes;
+#endif
+}
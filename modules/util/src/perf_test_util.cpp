@@ -0,0 +1,195 @@
+#include "util/include/perf_test_util.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "performance/include/hw_counters.hpp"
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/util.hpp"
+
+#ifdef _WIN32
+#  include <libenvpp/detail/get.hpp>
+#else
+#  include <unistd.h>
+
+#  include <array>
+#endif
+
+namespace {
+
+std::string GetCompilerInfo() {
+#if defined(__clang__)
+  return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+  return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+  return "unknown";
+#endif
+}
+
+std::string GetHostName() {
+#ifdef _WIN32
+  const auto name = env::get<std::string>("COMPUTERNAME");
+  return name.has_value() ? name.value() : std::string("unknown");
+#else
+  std::array<char, 256> name{};
+  if (gethostname(name.data(), name.size() - 1) != 0) {
+    return "unknown";
+  }
+  return {name.data()};
+#endif
+}
+
+std::string GetUtcTimestamp() {
+  const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  std::tm utc{};
+#ifdef _WIN32
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  std::ostringstream os;
+  os << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+  return os.str();
+}
+
+}  // namespace
+
+nlohmann::json ppc::util::MakePerfJsonRecord(const PerfRunInfo &info,
+                                             const ppc::performance::PerfResults &perf_results) {
+  nlohmann::json record;
+  record["test_name"] = info.test_name;
+  record["task_namespace"] = info.task_namespace;
+  record["type_of_task"] = ppc::task::TypeOfTaskToString(info.type_of_task);
+  record["mode"] = ppc::performance::GetStringParamName(info.mode);
+  record["input_size"] = info.input_size;
+
+  record["time_sec"] = perf_results.time_sec;
+  record["samples"] = perf_results.samples;
+  record["stats"] = {{"min", perf_results.min_sec},         {"median", perf_results.median_sec},
+                     {"mean", perf_results.mean_sec},       {"p90", perf_results.p90_sec},
+                     {"p99", perf_results.p99_sec},         {"stddev", perf_results.stddev_sec},
+                     {"median_rel_ci", perf_results.median_rel_ci}};
+  record["stage_timings"] = {{"validation", perf_results.stage_timings.validation_sec},
+                             {"preprocessing", perf_results.stage_timings.preprocessing_sec},
+                             {"run", perf_results.stage_timings.run_sec},
+                             {"postprocessing", perf_results.stage_timings.postprocessing_sec}};
+  const auto &memory = perf_results.memory;
+  const auto &stage_allocations = memory.stage_allocations;
+  record["memory"] = {{"allocation_hooks", memory.allocation_hooks},
+                      {"allocations_per_iteration", memory.allocations_per_iteration},
+                      {"bytes_per_iteration", memory.bytes_per_iteration},
+                      {"peak_rss_bytes", memory.peak_rss_bytes},
+                      {"stage_allocations",
+                       {{"validation", stage_allocations.validation.count},
+                        {"preprocessing", stage_allocations.preprocessing.count},
+                        {"run", stage_allocations.run.count},
+                        {"postprocessing", stage_allocations.postprocessing.count}}},
+                      {"stage_peak_rss_bytes",
+                       {{"validation", memory.stage_peak_rss.validation},
+                        {"preprocessing", memory.stage_peak_rss.preprocessing},
+                        {"run", memory.stage_peak_rss.run},
+                        {"postprocessing", memory.stage_peak_rss.postprocessing}}}};
+  if (perf_results.rank_times) {
+    record["rank_times"] = {{"num_ranks", perf_results.rank_times->num_ranks},
+                            {"min", perf_results.rank_times->min_sec},
+                            {"max", perf_results.rank_times->max_sec},
+                            {"mean", perf_results.rank_times->mean_sec},
+                            {"imbalance", perf_results.rank_times->imbalance}};
+  }
+  if (perf_results.hw_counters) {
+    auto &counters = record["hw_counters"];
+    for (std::size_t i = 0; i < ppc::performance::kNumHwCounters; i++) {
+      const std::string name(ppc::performance::kHwCounterNames[i]);
+      counters[name] = perf_results.hw_counters->available[i] ? nlohmann::json(perf_results.hw_counters->values[i])
+                                                               : nlohmann::json(nullptr);
+    }
+    counters["status"] = perf_results.hw_counters->status;
+  }
+
+  const auto &clock_info = ppc::util::Clock::GetInfo();
+  record["clock"] = {{"source", ppc::util::GetStringClockSource(clock_info.source)},
+                     {"resolution_sec", clock_info.resolution_sec},
+                     {"overhead_sec", clock_info.overhead_sec}};
+  record["num_threads"] = ppc::util::GetNumThreads();
+  record["num_proc"] = ppc::util::GetNumProc();
+  record["world_size"] = ppc::util::GetMPIWorldSize();
+  record["compiler"] = GetCompilerInfo();
+#ifdef PPC_CXX_FLAGS
+  record["cxx_flags"] = PPC_CXX_FLAGS;
+#else
+  record["cxx_flags"] = "unknown";
+#endif
+#ifdef PPC_BUILD_TYPE
+  record["build_type"] = PPC_BUILD_TYPE;
+#else
+  record["build_type"] = "unknown";
+#endif
+  record["host"] = GetHostName();
+  record["timestamp"] = GetUtcTimestamp();
+  return record;
+}
+
+std::string ppc::util::MakePerfBaselineKey(const PerfRunInfo &info) {
+  return info.task_namespace + ":" + ppc::task::TypeOfTaskToString(info.type_of_task) + ":" +
+         ppc::performance::GetStringParamName(info.mode) + ":threads=" + std::to_string(ppc::util::GetNumThreads()) +
+         ":procs=" + std::to_string(ppc::util::GetMPIWorldSize());
+}
+
+namespace {
+
+nlohmann::json ReadBaselineFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return nlohmann::json::object();
+  }
+  try {
+    return nlohmann::json::parse(file);
+  } catch (const nlohmann::json::parse_error &e) {
+    throw std::runtime_error("Failed to parse baseline " + path + ": " + e.what());
+  }
+}
+
+}  // namespace
+
+std::optional<std::vector<double>> ppc::util::LoadPerfBaseline(const std::string &path, const std::string &key) {
+  const auto baseline = ReadBaselineFile(path);
+  if (!baseline.contains(key) || !baseline[key].contains("samples")) {
+    return std::nullopt;
+  }
+  return baseline[key]["samples"].get<std::vector<double>>();
+}
+
+void ppc::util::StorePerfBaseline(const std::string &path, const std::string &key,
+                                  const ppc::performance::PerfResults &perf_results) {
+  auto baseline = ReadBaselineFile(path);
+  baseline[key] = {{"median", perf_results.median_sec},
+                   {"samples", perf_results.samples},
+                   {"timestamp", GetUtcTimestamp()},
+                   {"host", GetHostName()}};
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  file << baseline.dump(2) << '\n';
+}
+
+void ppc::util::AppendPerfJsonRecord(const std::string &path, const nlohmann::json &record) {
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  file << record.dump() << '\n';
+}
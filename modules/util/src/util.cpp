@@ -52,6 +52,93 @@ double ppc::util::GetPerfMaxTime() {
   return 10.0;
 }
 
+int ppc::util::GetPerfWarmup() {
+  const auto val = env::get<int>("PPC_PERF_WARMUP");
+  if (val.has_value() && val.value() >= 0) {
+    return val.value();
+  }
+  return 1;
+}
+
+double ppc::util::GetPerfTargetCI() {
+  const auto val = env::get<double>("PPC_PERF_TARGET_CI");
+  if (val.has_value() && val.value() > 0.0) {
+    return val.value();
+  }
+  return 0.0;
+}
+
+bool ppc::util::GetPerfHwCounters() {
+  const auto val = env::get<int>("PPC_PERF_COUNTERS");
+  return val.has_value() && val.value() != 0;
+}
+
+bool ppc::util::GetPerfSweep() {
+  const auto val = env::get<int>("PPC_PERF_SWEEP");
+  return val.has_value() && val.value() != 0;
+}
+
+std::string ppc::util::GetPerfJsonPath() {
+  const auto val = env::get<std::string>("PPC_PERF_JSON");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+std::string ppc::util::GetPerfBaselinePath() {
+  const auto val = env::get<std::string>("PPC_PERF_BASELINE");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return {};
+}
+
+bool ppc::util::GetPerfBaselineUpdate() {
+  const auto val = env::get<int>("PPC_PERF_BASELINE_UPDATE");
+  return val.has_value() && val.value() != 0;
+}
+
+double ppc::util::GetPerfTolerance() {
+  const auto val = env::get<double>("PPC_PERF_TOLERANCE");
+  if (val.has_value() && val.value() >= 0.0) {
+    return val.value();
+  }
+  return 0.1;
+}
+
+std::string ppc::util::GetPerfClock() {
+  const auto val = env::get<std::string>("PPC_PERF_CLOCK");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return "auto";
+}
+
+std::string ppc::util::GetPin() {
+  const auto val = env::get<std::string>("PPC_PIN");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return "none";
+}
+
+int ppc::util::GetCommGroups() {
+  const auto val = env::get<int>("PPC_COMM_GROUPS");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return 1;
+}
+
+std::string ppc::util::GetMpiThreads() {
+  const auto val = env::get<std::string>("PPC_MPI_THREADS");
+  if (val.has_value()) {
+    return val.value();
+  }
+  return "single";
+}
+
 // List of environment variables that signal the application is running under
 // an MPI launcher. The array size must match the number of entries to avoid
 // looking up empty environment variable names.
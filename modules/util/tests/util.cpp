@@ -1,10 +1,34 @@
 #include "util/include/util.hpp"
 
 #include <gtest/gtest.h>
+#include <mpi.h>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <libenvpp/detail/environment.hpp>
 #include <libenvpp/detail/get.hpp>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <tbb/global_control.h>
+#include <thread>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "performance/include/performance.hpp"
+#include "task/include/task.hpp"
+#include "util/include/aligned_allocator.hpp"
+#include "util/include/affinity.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/memory.hpp"
+#include "util/include/mpi_threads.hpp"
+#include "util/include/numa.hpp"
+#include "util/include/perf_test_util.hpp"
 
 #include "omp.h"
 
@@ -109,6 +133,49 @@ TEST(GetPerfMaxTime, ReadsFromEnvironment) {
   EXPECT_DOUBLE_EQ(ppc::util::GetPerfMaxTime(), 12.5);
 }
 
+TEST(GetPerfWarmup, ReturnsDefaultWhenUnset) {
+  const auto old = env::get<int>("PPC_PERF_WARMUP");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_WARMUP");
+  }
+  EXPECT_EQ(ppc::util::GetPerfWarmup(), 1);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_WARMUP", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfWarmup, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_WARMUP", "3");
+  EXPECT_EQ(ppc::util::GetPerfWarmup(), 3);
+}
+
+TEST(GetPerfTargetCI, DisabledWhenUnset) {
+  const auto old = env::get<double>("PPC_PERF_TARGET_CI");
+  if (old.has_value()) {
+    env::detail::delete_environment_variable("PPC_PERF_TARGET_CI");
+  }
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTargetCI(), 0.0);
+  if (old.has_value()) {
+    env::detail::set_environment_variable("PPC_PERF_TARGET_CI", std::to_string(*old));
+  }
+}
+
+TEST(GetPerfTargetCI, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_TARGET_CI", "0.05");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTargetCI(), 0.05);
+}
+
+TEST(GetPerfHwCounters, ReadsFromEnvironment) {
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_COUNTERS", "1");
+    EXPECT_TRUE(ppc::util::GetPerfHwCounters());
+  }
+  {
+    env::detail::set_scoped_environment_variable scoped("PPC_PERF_COUNTERS", "0");
+    EXPECT_FALSE(ppc::util::GetPerfHwCounters());
+  }
+}
+
 TEST(GetNumProc, ReturnsDefaultWhenUnset) {
   const auto old = env::get<int>("PPC_NUM_PROC");
   if (old.has_value()) {
@@ -124,3 +191,302 @@ TEST(GetNumProc, ReadsFromEnvironment) {
   env::detail::set_scoped_environment_variable scoped("PPC_NUM_PROC", "4");
   EXPECT_EQ(ppc::util::GetNumProc(), 4);
 }
+
+TEST(CountInputElements, FlattensContainersAndTuples) {
+  EXPECT_EQ(ppc::util::CountInputElements(42), 1U);
+  EXPECT_EQ(ppc::util::CountInputElements(std::vector<int>(7)), 7U);
+  EXPECT_EQ(ppc::util::CountInputElements(std::string("hello")), 5U);
+  const std::vector<std::vector<int>> matrix(3, std::vector<int>(4));
+  EXPECT_EQ(ppc::util::CountInputElements(matrix), 12U);
+  const std::tuple<std::vector<double>, int, std::string> tuple{std::vector<double>(2), 1, "abc"};
+  EXPECT_EQ(ppc::util::CountInputElements(tuple), 6U);
+  const std::variant<int, std::vector<int>> variant = std::vector<int>(5);
+  EXPECT_EQ(ppc::util::CountInputElements(variant), 5U);
+}
+
+TEST(PerfJsonRecord, ContainsResultsAndMetadata) {
+  ppc::performance::PerfResults results;
+  results.samples = {1.0, 2.0, 3.0};
+  ppc::performance::ComputeStatistics(results);
+
+  const ppc::util::PerfRunInfo info{.test_name = "ns_seq_enabled",
+                                    .task_namespace = "ns",
+                                    .type_of_task = ppc::task::TypeOfTask::kSEQ,
+                                    .mode = ppc::performance::PerfResults::TypeOfRunning::kPipeline,
+                                    .input_size = 100};
+  const auto record = ppc::util::MakePerfJsonRecord(info, results);
+  EXPECT_EQ(record["task_namespace"], "ns");
+  EXPECT_EQ(record["type_of_task"], "seq");
+  EXPECT_EQ(record["mode"], "pipeline");
+  EXPECT_EQ(record["input_size"], 100);
+  EXPECT_EQ(record["samples"].size(), 3U);
+  EXPECT_DOUBLE_EQ(record["stats"]["median"].get<double>(), 2.0);
+  EXPECT_EQ(record["num_threads"], ppc::util::GetNumThreads());
+  EXPECT_TRUE(record.contains("compiler"));
+  EXPECT_TRUE(record.contains("host"));
+  EXPECT_FALSE(record.contains("hw_counters"));
+}
+
+TEST(PerfJsonRecord, AppendsOneLinePerRecord) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_json_test.jsonl").string();
+  std::filesystem::remove(path);
+  ppc::util::AppendPerfJsonRecord(path, nlohmann::json{{"a", 1}});
+  ppc::util::AppendPerfJsonRecord(path, nlohmann::json{{"a", 2}});
+
+  std::ifstream file(path);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line)) {
+    EXPECT_EQ(nlohmann::json::parse(line)["a"], ++lines);
+  }
+  EXPECT_EQ(lines, 2);
+  std::filesystem::remove(path);
+}
+
+TEST(MemoryAccounting, CountsAllocationsOnlyWithHooks) {
+  const auto before = ppc::util::ReadAllocationCounters();
+  auto data = std::make_unique<std::vector<int>>(256);
+  const auto delta = ppc::util::ReadAllocationCounters() - before;
+  EXPECT_EQ(data->size(), 256U);
+  if (ppc::util::AllocationHooksLinked()) {
+    EXPECT_GE(delta.count, 2U);
+    EXPECT_GE(delta.bytes, 256 * sizeof(int));
+  } else {
+    EXPECT_EQ(delta.count, 0U);
+    EXPECT_EQ(delta.bytes, 0U);
+  }
+}
+
+#ifdef __linux__
+TEST(MemoryAccounting, ReadsResidentSetSize) {
+  EXPECT_GT(ppc::util::GetCurrentRssBytes(), 0U);
+  EXPECT_GE(ppc::util::GetPeakRssBytes(), ppc::util::GetCurrentRssBytes());
+}
+
+TEST(MemoryAccounting, ResetsPeakResidentSetSize) {
+  constexpr std::size_t kBytes = std::size_t{64} << 20;
+  {
+    std::vector<char> buffer(kBytes, 1);
+    EXPECT_EQ(buffer.back(), 1);
+  }
+  const auto peak = ppc::util::GetPeakRssBytes();
+  if (!ppc::util::ResetPeakRss()) {
+    GTEST_SKIP() << "/proc/self/clear_refs is not writable";
+  }
+  EXPECT_LT(ppc::util::GetPeakRssBytes() + (kBytes / 2), peak);
+}
+#endif
+
+TEST(GetPerfTolerance, ReadsFromEnvironment) {
+  env::detail::set_scoped_environment_variable scoped("PPC_PERF_TOLERANCE", "0.25");
+  EXPECT_DOUBLE_EQ(ppc::util::GetPerfTolerance(), 0.25);
+}
+
+TEST(PerfBaseline, StoresAndLoadsSamplesPerKey) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_test.json").string();
+  std::filesystem::remove(path);
+  const ppc::util::PerfRunInfo info{.test_name = "ns_omp_enabled",
+                                    .task_namespace = "ns",
+                                    .type_of_task = ppc::task::TypeOfTask::kOMP,
+                                    .mode = ppc::performance::PerfResults::TypeOfRunning::kTaskRun,
+                                    .input_size = 10};
+  const auto key = ppc::util::MakePerfBaselineKey(info);
+  EXPECT_EQ(key.rfind("ns:omp:task_run:threads=", 0), 0U);
+  EXPECT_FALSE(ppc::util::LoadPerfBaseline(path, key).has_value());
+
+  ppc::performance::PerfResults results;
+  results.samples = {0.5, 0.4, 0.6};
+  ppc::performance::ComputeStatistics(results);
+  ppc::util::StorePerfBaseline(path, key, results);
+  ppc::util::StorePerfBaseline(path, "other", results);
+
+  const auto loaded = ppc::util::LoadPerfBaseline(path, key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(*loaded, results.samples);
+  EXPECT_TRUE(ppc::util::LoadPerfBaseline(path, "other").has_value());
+  EXPECT_FALSE(ppc::util::LoadPerfBaseline(path, "missing").has_value());
+  std::filesystem::remove(path);
+}
+
+TEST(ScopedNumThreads, SetsAndRestoresThreadCounts) {
+  const int prev_threads = ppc::util::GetNumThreads();
+  const int prev_omp_threads = omp_get_max_threads();
+  {
+    const ppc::util::ScopedNumThreads scope(1);
+    EXPECT_EQ(ppc::util::GetNumThreads(), 1);
+    EXPECT_EQ(omp_get_max_threads(), 1);
+    EXPECT_EQ(tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism), 1U);
+  }
+  EXPECT_EQ(ppc::util::GetNumThreads(), prev_threads);
+  EXPECT_EQ(omp_get_max_threads(), prev_omp_threads);
+}
+
+TEST(ThreadAffinity, ParsesPinPolicy) {
+  EXPECT_EQ(ppc::util::ParsePinPolicy("none"), ppc::util::PinPolicy::kNone);
+  EXPECT_EQ(ppc::util::ParsePinPolicy("compact"), ppc::util::PinPolicy::kCompact);
+  EXPECT_EQ(ppc::util::ParsePinPolicy("scatter"), ppc::util::PinPolicy::kScatter);
+  EXPECT_THROW(ppc::util::ParsePinPolicy("close"), std::invalid_argument);
+  env::detail::set_scoped_environment_variable scoped("PPC_PIN", "scatter");
+  EXPECT_EQ(ppc::util::GetPin(), "scatter");
+}
+
+TEST(ThreadAffinity, SplitsCpusBetweenRanks) {
+  const std::vector<int> cpus = {0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(ppc::util::SelectRankCpus(cpus, 1, 2, ppc::util::PinPolicy::kCompact), (std::vector<int>{4, 5, 6, 7}));
+  EXPECT_EQ(ppc::util::SelectRankCpus(cpus, 1, 2, ppc::util::PinPolicy::kScatter), (std::vector<int>{1, 3, 5, 7}));
+  EXPECT_EQ(ppc::util::SelectRankCpus(cpus, 1, 2, ppc::util::PinPolicy::kNone), cpus);
+  EXPECT_EQ(ppc::util::SelectRankCpus({0, 1}, 2, 3, ppc::util::PinPolicy::kCompact), (std::vector<int>{0}));
+
+  const std::vector<int> rank_cpus = {4, 5, 6, 7};
+  EXPECT_EQ(ppc::util::SelectThreadCpu(rank_cpus, 1, 2, ppc::util::PinPolicy::kCompact), 5);
+  EXPECT_EQ(ppc::util::SelectThreadCpu(rank_cpus, 1, 2, ppc::util::PinPolicy::kScatter), 6);
+  EXPECT_EQ(ppc::util::SelectThreadCpu(rank_cpus, 5, 8, ppc::util::PinPolicy::kScatter), 5);
+  EXPECT_EQ(ppc::util::SelectThreadCpu(rank_cpus, 1, 2, ppc::util::PinPolicy::kNone), -1);
+
+  EXPECT_EQ(ppc::util::FormatCpuList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+}
+
+TEST(ThreadAffinity, PinsThreadsToRankCpus) {
+  const std::vector<int> original = ppc::util::GetThreadAffinity();
+  if (original.empty()) {
+    GTEST_SKIP() << "Thread affinity is not supported on this platform";
+  }
+  const std::vector<int> rank_cpus = {original.front()};
+  {
+    const ppc::util::ThreadPinning pinning(ppc::util::PinPolicy::kCompact, rank_cpus, 2);
+    EXPECT_EQ(ppc::util::GetThreadAffinity(), rank_cpus);
+    EXPECT_EQ(pinning.GetThreadCpu(1), original.front());
+    EXPECT_NE(pinning.Describe().find("policy=compact"), std::string::npos);
+
+    std::vector<int> stl_affinity;
+    std::thread worker([&stl_affinity] {
+      ppc::util::PinCurrentThread(1);
+      stl_affinity = ppc::util::GetThreadAffinity();
+    });
+    worker.join();
+    EXPECT_EQ(stl_affinity, rank_cpus);
+  }
+  ppc::util::SetThreadAffinity(original);
+#pragma omp parallel num_threads(2)
+  ppc::util::SetThreadAffinity(original);
+}
+
+TEST(ThreadAffinity, RepinsOmpTeamAndRestoresPreviousPinning) {
+  const std::vector<int> original = ppc::util::GetThreadAffinity();
+  if (original.empty()) {
+    GTEST_SKIP() << "Thread affinity is not supported on this platform";
+  }
+  {
+    const ppc::util::ThreadPinning outer(ppc::util::PinPolicy::kCompact, original, 2);
+    {
+      const ppc::util::ThreadPinning inner(ppc::util::PinPolicy::kCompact, {original.front()}, 2);
+    }
+
+    std::vector<int> stl_affinity;
+    std::thread worker([&stl_affinity] {
+      ppc::util::PinCurrentThread(1);
+      stl_affinity = ppc::util::GetThreadAffinity();
+    });
+    worker.join();
+    EXPECT_EQ(stl_affinity, std::vector<int>{outer.GetThreadCpu(1)});
+
+#if _OPENMP >= 201811
+    // A paused runtime starts a fresh team, which PinOmpThreads() binds again
+    omp_pause_resource_all(omp_pause_soft);
+#endif
+    ppc::util::PinOmpThreads();
+    std::vector<int> omp_affinity;
+#pragma omp parallel num_threads(2)
+    {
+      if (omp_get_thread_num() == 1) {
+        omp_affinity = ppc::util::GetThreadAffinity();
+      }
+    }
+    if (omp_get_max_threads() > 1) {
+      EXPECT_EQ(omp_affinity, std::vector<int>{outer.GetThreadCpu(1)});
+    }
+  }
+  ppc::util::SetThreadAffinity(original);
+#pragma omp parallel num_threads(2)
+  ppc::util::SetThreadAffinity(original);
+}
+
+TEST(ClockTest, IsMonotonicAndReportsItsProperties) {
+  const double first = ppc::util::Clock::Now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  const double second = ppc::util::Clock::Now();
+  EXPECT_GE(second - first, 0.009);
+  EXPECT_LT(second - first, 1.0);
+
+  const auto &info = ppc::util::Clock::GetInfo();
+  EXPECT_GT(info.resolution_sec, 0.0);
+  EXPECT_LT(info.resolution_sec, 1e-3);
+  EXPECT_GT(info.overhead_sec, 0.0);
+  EXPECT_LT(info.overhead_sec, 1e-4);
+  EXPECT_EQ(info.source == ppc::util::ClockSource::kTsc, info.tsc_hz > 0.0);
+  EXPECT_EQ(ppc::util::GetStringClockSource(ppc::util::ClockSource::kSteady), "steady");
+}
+
+TEST(NumaPlacement, FirstTouchFillOverwritesDiscardedPages) {
+  std::vector<int> data(1 << 20, -1);
+  ppc::util::FirstTouchFill(std::span<int>(data), [](std::size_t i) { return static_cast<int>(i % 1000); });
+  for (std::size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(data[i], static_cast<int>(i % 1000));
+  }
+  EXPECT_GE(ppc::util::GetNumaNodeCount(), 1);
+}
+
+TEST(NumaPlacement, ReportsResidentPagesPerNode) {
+  const ppc::util::FirstTouchVector<double> untouched(1 << 18);
+  std::vector<double> touched(1 << 18, 1.0);
+  const auto placement = ppc::util::GetPagePlacement(touched.data(), touched.size() * sizeof(double));
+  if (placement.empty()) {
+    GTEST_SKIP() << "Page placement cannot be queried on this system";
+  }
+  std::size_t resident = 0;
+  for (std::size_t pages : placement) {
+    resident += pages;
+  }
+  EXPECT_GE(resident, touched.size() * sizeof(double) / 4096 / 2);
+  EXPECT_EQ(ppc::util::GetInputPagePlacement(std::make_tuple(7, touched)), placement);
+  EXPECT_NE(ppc::util::FormatPagePlacement(placement).find("node0="), std::string::npos);
+  EXPECT_EQ(ppc::util::FormatPagePlacement({}), "n/a");
+}
+
+TEST(AlignedAllocator, AlignsSmallAndLargeBuffers) {
+  const ppc::util::AlignedVector<char> small(3, 'x');
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small.data()) % ppc::util::kCacheLineSize, 0U);
+
+  ppc::util::AlignedVector<double> large(ppc::util::kHugePageSize / sizeof(double) + 5, 1.5);
+  const auto address = reinterpret_cast<std::uintptr_t>(large.data());
+  EXPECT_EQ(address % (ppc::util::HugePagesEnabled() ? ppc::util::kHugePageSize : ppc::util::kCacheLineSize), 0U);
+  large.push_back(2.5);
+  EXPECT_DOUBLE_EQ(large.front(), 1.5);
+  EXPECT_DOUBLE_EQ(large.back(), 2.5);
+
+  using WideAllocator = ppc::util::AlignedAllocator<int, 256>;
+  std::vector<int, WideAllocator> wide(10);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide.data()) % 256, 0U);
+}
+
+TEST(MpiThreads, ParsesThreadLevel) {
+  EXPECT_EQ(ppc::util::ParseMpiThreadLevel("single"), MPI_THREAD_SINGLE);
+  EXPECT_EQ(ppc::util::ParseMpiThreadLevel("funneled"), MPI_THREAD_FUNNELED);
+  EXPECT_EQ(ppc::util::ParseMpiThreadLevel("serialized"), MPI_THREAD_SERIALIZED);
+  EXPECT_EQ(ppc::util::ParseMpiThreadLevel("multiple"), MPI_THREAD_MULTIPLE);
+  EXPECT_THROW(ppc::util::ParseMpiThreadLevel("MULTIPLE"), std::invalid_argument);
+  EXPECT_EQ(ppc::util::GetStringMpiThreadLevel(MPI_THREAD_SERIALIZED), "serialized");
+}
+
+TEST(MpiThreads, ThreadCommsNeedThreadMultiple) {
+  if (ppc::util::GetProvidedMpiThreadLevel() < MPI_THREAD_MULTIPLE) {
+    EXPECT_THROW(ppc::util::ThreadComms(MPI_COMM_WORLD, 2), std::runtime_error);
+    return;
+  }
+  const ppc::util::ThreadComms comms(MPI_COMM_WORLD, 2);
+  ASSERT_EQ(comms.GetNumThreads(), 2);
+  int result = MPI_UNEQUAL;
+  MPI_Comm_compare(comms.Get(0), MPI_COMM_WORLD, &result);
+  EXPECT_EQ(result, MPI_CONGRUENT);
+  EXPECT_NE(comms.Get(0), comms.Get(1));
+}
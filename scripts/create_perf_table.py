@@ -1,4 +1,5 @@
 import argparse
+import json
 import os
 import re
 import xlsxwriter
@@ -130,7 +131,10 @@ def _write_csv(path: str, header: list[str], tasks_list: list[str], table: dict)
 
 parser = argparse.ArgumentParser()
 parser.add_argument(
-    "-i", "--input", help="Input file path (logs of perf tests, .txt)", required=True
+    "-i",
+    "--input",
+    help="Input file path (logs of perf tests, .txt, or PPC_PERF_JSON records, .jsonl)",
+    required=True,
 )
 parser.add_argument(
     "-o", "--output", help="Output file path (path to .xlsx table)", required=True
@@ -146,8 +150,24 @@ task_categories = {}
 # Track tasks per category to split output
 tasks_by_category = {"threads": set(), "processes": set()}
 
+# Structured records written by the perf harness when PPC_PERF_JSON is set
+json_input = logs_path.endswith((".json", ".jsonl"))
 with open(logs_path, "r") as logs_file:
-    logs_lines = logs_file.readlines()
+    logs_lines = [] if json_input else logs_file.readlines()
+    json_records = (
+        [json.loads(line) for line in logs_file if line.strip()] if json_input else []
+    )
+
+for record in json_records:
+    task_name = record["task_namespace"]
+    task_type = record["type_of_task"]
+    perf_type = record["mode"]
+    task_category = _infer_category(task_name)
+    _ensure_task_tables(result_tables, perf_type, task_name)
+    result_tables[perf_type][task_name][task_type] = float(record["time_sec"])
+    task_categories[task_name] = task_category
+    tasks_by_category[task_category].add(task_name)
+
 for line in logs_lines:
     # Handle both old format: tasks/task_type/task_name:perf_type:time
     # and new format: namespace_task_type_enabled:perf_type:time
@@ -2,15 +2,15 @@
 
 #include <string>
 #include <tuple>
-#include <vector>
 
 #include "task/include/task.hpp"
+#include "util/include/aligned_allocator.hpp"
 
 namespace balchunayte_z_dot_product {
 
 struct InType {
-  std::vector<double> a;
-  std::vector<double> b;
+  ppc::util::AlignedVector<double> a;
+  ppc::util::AlignedVector<double> b;
 };
 
 using OutType = double;
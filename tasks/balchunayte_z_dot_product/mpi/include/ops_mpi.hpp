@@ -1,9 +1,8 @@
 #pragma once
 
-#include <vector>
-
 #include "balchunayte_z_dot_product/common/include/common.hpp"
 #include "task/include/task.hpp"
+#include "util/include/aligned_allocator.hpp"
 
 namespace balchunayte_z_dot_product {
 
@@ -25,8 +24,8 @@ class BalchunayteZDotProductMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  std::vector<double> local_a_;
-  std::vector<double> local_b_;
+  ppc::util::AlignedVector<double> local_a_;
+  ppc::util::AlignedVector<double> local_b_;
   int world_rank_{0};
   int world_size_{1};
   int local_size_{0};
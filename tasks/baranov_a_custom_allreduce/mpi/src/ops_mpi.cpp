@@ -8,6 +8,7 @@
 #include <cstring>
 #include <exception>
 #include <stdexcept>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -15,6 +16,21 @@
 
 namespace baranov_a_custom_allreduce {
 
+namespace {
+
+template <typename T>
+MPI_Datatype GetDatatype() {
+  if constexpr (std::is_same_v<T, int>) {
+    return MPI_INT;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return MPI_FLOAT;
+  } else {
+    return MPI_DOUBLE;
+  }
+}
+
+}  // namespace
+
 void BaranovACustomAllreduceMPI::TreeBroadcast(void *buffer, int count, MPI_Datatype datatype, MPI_Comm comm,
                                                int root) {
   int rank = 0;
@@ -170,16 +186,8 @@ template std::vector<double> BaranovACustomAllreduceMPI::GetVectorFromVariant<do
 BaranovACustomAllreduceMPI::BaranovACustomAllreduceMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
-  if (std::holds_alternative<std::vector<int>>(in)) {
-    auto vec = std::get<std::vector<int>>(in);
-    GetOutput() = InTypeVariant{std::vector<int>(vec.size(), 0)};
-  } else if (std::holds_alternative<std::vector<float>>(in)) {
-    auto vec = std::get<std::vector<float>>(in);
-    GetOutput() = InTypeVariant{std::vector<float>(vec.size(), 0.0F)};
-  } else {
-    auto vec = std::get<std::vector<double>>(in);
-    GetOutput() = InTypeVariant{std::vector<double>(vec.size(), 0.0)};
-  }
+  GetOutput() =
+      std::visit([](const auto &vec) -> InTypeVariant { return std::decay_t<decltype(vec)>(vec.size()); }, in);
 }
 
 bool BaranovACustomAllreduceMPI::ValidationImpl() {
@@ -192,41 +200,19 @@ bool BaranovACustomAllreduceMPI::PreProcessingImpl() {
 
 bool BaranovACustomAllreduceMPI::RunImpl() {
   try {
-    auto input = GetInput();
-    auto output = GetOutput();
-
-    if (std::holds_alternative<std::vector<int>>(input)) {
-      auto data = std::get<std::vector<int>>(input);
-      if (data.empty()) {
-        GetOutput() = InTypeVariant{std::vector<int>{}};
-        return true;
-      }
-      auto result_data = std::get<std::vector<int>>(output);
-      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_INT, MPI_SUM, MPI_COMM_WORLD,
-                      0);
-
-      GetOutput() = InTypeVariant{result_data};
-    } else if (std::holds_alternative<std::vector<float>>(input)) {
-      auto data = std::get<std::vector<float>>(input);
-      if (data.empty()) {
-        GetOutput() = InTypeVariant{std::vector<float>{}};
-        return true;
-      }
-      auto result_data = std::get<std::vector<float>>(output);
-      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_FLOAT, MPI_SUM,
-                      MPI_COMM_WORLD, 0);
-      GetOutput() = InTypeVariant{result_data};
-    } else if (std::holds_alternative<std::vector<double>>(input)) {
-      auto data = std::get<std::vector<double>>(input);
-      if (data.empty()) {
-        GetOutput() = InTypeVariant{std::vector<double>{}};
-        return true;
-      }
-      auto result_data = std::get<std::vector<double>>(output);
-      CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()), MPI_DOUBLE, MPI_SUM,
-                      MPI_COMM_WORLD, 0);
-      GetOutput() = InTypeVariant{result_data};
-    }
+    // Every alternative is a vector of a summable type, so one generic path serves all of them
+    GetOutput() = std::visit(
+        [](const auto &input) -> InTypeVariant {
+          using Vector = std::decay_t<decltype(input)>;
+          Vector data = input;
+          Vector result_data(data.size());
+          if (!data.empty()) {
+            CustomAllreduce(data.data(), result_data.data(), static_cast<int>(data.size()),
+                            GetDatatype<typename Vector::value_type>(), MPI_SUM, MPI_COMM_WORLD, 0);
+          }
+          return result_data;
+        },
+        GetInput());
     return true;
   } catch (const std::exception &) {
     return false;
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <mpi.h>
-
 #include <string>
 #include <tuple>
 #include <vector>
@@ -33,7 +31,6 @@ class BelovELexicoOrderTwoStringsMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 };
-void BcastVectorOfStrings(std::vector<std::string> &vec, int n, MPI_Comm comm);
 ChunkAns ChunkCheck(const std::vector<std::string> &first, const std::vector<std::string> &second, int begin, int end);
 int CeilDiv(int a, int b);
 }  // namespace belov_e_lexico_order_two_strings
@@ -5,9 +5,11 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "belov_e_lexico_order_two_strings/common/include/common.hpp"
+#include "comm/include/serializer.hpp"
 
 namespace belov_e_lexico_order_two_strings {
 BelovELexicoOrderTwoStringsMPI::BelovELexicoOrderTwoStringsMPI(const InType &in) {
@@ -73,30 +75,6 @@ int CeilDiv(int a, int b) {
   return (a + b - 1) / b;
 }
 
-void BcastVectorOfStrings(std::vector<std::string> &vec, int n, MPI_Comm comm) {
-  int rank = 0;
-  MPI_Comm_rank(comm, &rank);
-
-  if (rank != 0) {
-    vec.resize(n);
-  }
-
-  for (int i = 0; i < n; i++) {
-    int len = 0;
-    if (rank == 0) {
-      len = static_cast<int>(vec[i].size());
-    }
-
-    MPI_Bcast(&len, 1, MPI_INT, 0, comm);
-
-    if (rank != 0) {
-      vec[i].resize(len);
-    }
-
-    MPI_Bcast(vec[i].data(), len, MPI_CHAR, 0, comm);
-  }
-}
-
 bool BelovELexicoOrderTwoStringsMPI::RunImpl() {
   int mpi_size = 0;
   int rank = 0;
@@ -104,28 +82,25 @@ bool BelovELexicoOrderTwoStringsMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
-  std::vector<std::string> first;
-  std::vector<std::string> second;
+  std::tuple<std::vector<std::string>, std::vector<std::string>> words;
 
   int n1 = 0;
   int n2 = 0;
-  int n = 0;
 
   if (rank == 0) {
-    first = std::get<0>(GetProccesedInput());
-    second = std::get<1>(GetProccesedInput());
+    words = GetProccesedInput();
 
-    n1 = static_cast<int>(first.size());
-    n2 = static_cast<int>(second.size());
+    n1 = static_cast<int>(std::get<0>(words).size());
+    n2 = static_cast<int>(std::get<1>(words).size());
+    std::get<0>(words).resize(std::min(n1, n2));
+    std::get<1>(words).resize(std::min(n1, n2));
   }
 
-  MPI_Bcast(&n1, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  MPI_Bcast(&n2, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  n = std::min(n1, n2);
+  // Both word lists travel as one packed buffer instead of two messages per word
+  ppc::comm::Broadcast(words, 0, MPI_COMM_WORLD);
 
-  BcastVectorOfStrings(first, n, MPI_COMM_WORLD);
-  BcastVectorOfStrings(second, n, MPI_COMM_WORLD);
+  const auto &[first, second] = words;
+  const int n = static_cast<int>(first.size());
 
   int chunk = CeilDiv(n, mpi_size);
   int begin = rank * chunk;
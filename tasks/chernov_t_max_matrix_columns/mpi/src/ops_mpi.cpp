@@ -5,15 +5,16 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <utility>
 #include <vector>
 
 #include "chernov_t_max_matrix_columns/common/include/common.hpp"
 
 namespace chernov_t_max_matrix_columns {
 
-ChernovTMaxMatrixColumnsMPI::ChernovTMaxMatrixColumnsMPI(const InType &in) {
+ChernovTMaxMatrixColumnsMPI::ChernovTMaxMatrixColumnsMPI(InType in) {
   SetTypeOfTask(GetStaticTypeOfTask());
-  GetInput() = in;
+  GetInput() = std::move(in);
   GetOutput() = std::vector<int>();
 }
 
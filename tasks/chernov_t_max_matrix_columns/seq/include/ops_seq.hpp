@@ -13,7 +13,7 @@ class ChernovTMaxMatrixColumnsSEQ : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kSEQ;
   }
-  explicit ChernovTMaxMatrixColumnsSEQ(const InType &in);
+  explicit ChernovTMaxMatrixColumnsSEQ(InType in);
 
  private:
   bool ValidationImpl() override;
@@ -1,12 +1,15 @@
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <span>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "chernov_t_max_matrix_columns/common/include/common.hpp"
 #include "chernov_t_max_matrix_columns/mpi/include/ops_mpi.hpp"
 #include "chernov_t_max_matrix_columns/seq/include/ops_seq.hpp"
+#include "util/include/numa.hpp"
 #include "util/include/perf_test_util.hpp"
 
 namespace chernov_t_max_matrix_columns {
@@ -20,13 +23,13 @@ class ChernovTPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
   void SetUp() override {
     std::vector<int> matrix_data(kRows_ * kCols_);
 
-    for (std::size_t i = 0; i < kRows_; ++i) {
-      for (std::size_t j = 0; j < kCols_; ++j) {
-        int value = static_cast<int>(((i * 13 + j * 29) % 1000) + 1);
-        matrix_data[(i * kCols_) + j] = value;
-      }
-    }
-    input_data_ = std::make_tuple(kRows_, kCols_, matrix_data);
+    const std::size_t cols = kCols_;
+    ppc::util::FirstTouchFill(std::span<int>(matrix_data), [cols](std::size_t idx) {
+      const std::size_t i = idx / cols;
+      const std::size_t j = idx % cols;
+      return static_cast<int>(((i * 13 + j * 29) % 1000) + 1);
+    });
+    input_data_ = std::make_tuple(kRows_, kCols_, std::move(matrix_data));
   }
 
   bool CheckTestOutputData(OutType &output_data) final {
@@ -36,6 +39,10 @@ class ChernovTPerfTest : public ppc::util::BaseRunPerfTests<InType, OutType> {
   InType GetTestInputData() final {
     return input_data_;
   }
+
+  InType TakeTestInputData() final {
+    return std::move(input_data_);
+  }
 };
 
 TEST_P(ChernovTPerfTest, RunPerfModes) {
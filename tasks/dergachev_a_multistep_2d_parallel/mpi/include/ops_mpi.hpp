@@ -12,6 +12,7 @@ class DergachevAMultistep2dParallelMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
   explicit DergachevAMultistep2dParallelMPI(const InType &in);
 
  private:
@@ -31,8 +32,8 @@ class DergachevAMultistep2dParallelMPI : public BaseTask {
   std::vector<double> t_values_;
   double m_estimate_{1.0};
   int peano_level_{10};
-  int world_rank_{0};
-  int world_size_{1};
+  int rank_{0};
+  int size_{1};
 };
 
 }  // namespace dergachev_a_multistep_2d_parallel
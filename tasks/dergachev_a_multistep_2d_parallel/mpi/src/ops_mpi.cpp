@@ -9,26 +9,14 @@
 #include <utility>
 #include <vector>
 
+#include "comm/include/collectives.hpp"
+#include "comm/include/partition.hpp"
 #include "dergachev_a_multistep_2d_parallel/common/include/common.hpp"
 
 namespace dergachev_a_multistep_2d_parallel {
 
 namespace {
 
-void ComputeDistribution(int num_intervals, int world_size, std::vector<int> &counts, std::vector<int> &displs) {
-  counts.resize(static_cast<std::size_t>(world_size));
-  displs.resize(static_cast<std::size_t>(world_size));
-
-  int base_count = num_intervals / world_size;
-  int remainder = num_intervals % world_size;
-
-  for (int i = 0; i < world_size; ++i) {
-    auto idx = static_cast<std::size_t>(i);
-    counts[idx] = base_count + ((i < remainder) ? 1 : 0);
-    displs[idx] = (i == 0) ? 0 : (displs[idx - 1] + counts[idx - 1]);
-  }
-}
-
 void PrepareIntervalData(const std::vector<double> &t_values, const std::vector<TrialPoint> &trials, int num_intervals,
                          std::vector<double> &interval_data) {
   interval_data.resize(static_cast<std::size_t>(num_intervals) * 4);
@@ -57,49 +45,19 @@ void ComputeLocalCharacteristics(const std::vector<double> &local_interval_data,
   }
 }
 
-void GatherResultsToRoot(const std::vector<double> &local_chars, const std::vector<int> &counts,
-                         const std::vector<int> &displs, int world_rank, int world_size,
-                         std::vector<double> &characteristics) {
-  int local_count = counts[static_cast<std::size_t>(world_rank)];
-
-  if (world_rank == 0) {
-    for (int i = 0; i < counts[0]; ++i) {
-      characteristics[static_cast<std::size_t>(i)] = local_chars[static_cast<std::size_t>(i)];
-    }
-
-    for (int proc = 1; proc < world_size; ++proc) {
-      auto proc_idx = static_cast<std::size_t>(proc);
-      int proc_count = counts[proc_idx];
-      if (proc_count > 0) {
-        std::vector<double> recv_chars(static_cast<std::size_t>(proc_count));
-        MPI_Recv(recv_chars.data(), proc_count, MPI_DOUBLE, proc, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-        int disp = displs[proc_idx];
-        for (int i = 0; i < proc_count; ++i) {
-          characteristics[static_cast<std::size_t>(disp) + static_cast<std::size_t>(i)] =
-              recv_chars[static_cast<std::size_t>(i)];
-        }
-      }
-    }
-  } else {
-    if (local_count > 0) {
-      MPI_Send(local_chars.data(), local_count, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-    }
-  }
-}
-
 }  // namespace
 
 DergachevAMultistep2dParallelMPI::DergachevAMultistep2dParallelMPI(const InType &in) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
   GetOutput() = OutType();
-
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank_);
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size_);
 }
 
 bool DergachevAMultistep2dParallelMPI::ValidationImpl() {
-  if (world_rank_ != 0) {
+  MPI_Comm_rank(GetComm(), &rank_);
+  MPI_Comm_size(GetComm(), &size_);
+
+  if (rank_ != 0) {
     return true;
   }
 
@@ -130,7 +88,7 @@ bool DergachevAMultistep2dParallelMPI::RunImpl() {
 
   std::vector<double> initial_data(8);
 
-  if (world_rank_ == 0) {
+  if (rank_ == 0) {
     double t0 = 0.0;
     double t1 = 1.0;
 
@@ -151,11 +109,11 @@ bool DergachevAMultistep2dParallelMPI::RunImpl() {
     initial_data[6] = y1;
     initial_data[7] = z1;
 
-    for (int proc = 1; proc < world_size_; ++proc) {
-      MPI_Send(initial_data.data(), 8, MPI_DOUBLE, proc, 0, MPI_COMM_WORLD);
+    for (int proc = 1; proc < size_; ++proc) {
+      MPI_Send(initial_data.data(), 8, MPI_DOUBLE, proc, 0, GetComm());
     }
   } else {
-    MPI_Recv(initial_data.data(), 8, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(initial_data.data(), 8, MPI_DOUBLE, 0, 0, GetComm(), MPI_STATUS_IGNORE);
   }
 
   t_values_.push_back(initial_data[0]);
@@ -193,7 +151,7 @@ bool DergachevAMultistep2dParallelMPI::RunImpl() {
     double delta = t_right - t_left;
     int converged_flag = (delta < input.epsilon) ? 1 : 0;
 
-    MPI_Bcast(&converged_flag, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&converged_flag, 1, MPI_INT, 0, GetComm());
 
     if (converged_flag != 0) {
       output.converged = true;
@@ -201,7 +159,7 @@ bool DergachevAMultistep2dParallelMPI::RunImpl() {
       break;
     }
 
-    if (world_rank_ == 0) {
+    if (rank_ == 0) {
       double z_new = PerformTrial(t_new);
       double x_new = PeanoToX(t_new, input.x_min, input.x_max, input.y_min, input.y_max, peano_level_);
       double y_new = PeanoToY(t_new, input.x_min, input.x_max, input.y_min, input.y_max, peano_level_);
@@ -278,37 +236,24 @@ void DergachevAMultistep2dParallelMPI::ComputeCharacteristicsParallel(double m_v
     return;
   }
 
-  std::vector<int> counts;
-  std::vector<int> displs;
-  ComputeDistribution(num_intervals, world_size_, counts, displs);
+  // The number of intervals grows every iteration, so the plans are built here rather than taken from the cache
+  const auto interval_plan = ppc::comm::PartitionPlan::Block(num_intervals, size_, 4);
+  const auto char_plan = ppc::comm::PartitionPlan::Block(num_intervals, size_);
 
   std::vector<double> interval_data;
-  if (world_rank_ == 0) {
+  if (rank_ == 0) {
     PrepareIntervalData(t_values_, trials_, num_intervals, interval_data);
-  } else {
-    interval_data.resize(static_cast<std::size_t>(num_intervals) * 4);
   }
 
-  std::vector<int> send_counts(static_cast<std::size_t>(world_size_));
-  std::vector<int> send_displs(static_cast<std::size_t>(world_size_));
-  for (int i = 0; i < world_size_; ++i) {
-    auto idx = static_cast<std::size_t>(i);
-    send_counts[idx] = counts[idx] * 4;
-    send_displs[idx] = displs[idx] * 4;
-  }
-
-  int local_count = counts[static_cast<std::size_t>(world_rank_)];
-  std::vector<double> local_interval_data(static_cast<std::size_t>(local_count) * 4);
-  MPI_Scatterv(interval_data.data(), send_counts.data(), send_displs.data(), MPI_DOUBLE, local_interval_data.data(),
-               local_count * 4, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  const auto local_count = static_cast<int>(char_plan.GetCount(rank_));
+  std::vector<double> local_interval_data(static_cast<std::size_t>(interval_plan.GetCount(rank_)));
+  ppc::comm::Scatterv(interval_data.data(), local_interval_data.data(), interval_plan, 0, GetComm());
 
   std::vector<double> local_chars;
   ComputeLocalCharacteristics(local_interval_data, local_count, m_val, local_chars);
 
   characteristics.resize(static_cast<std::size_t>(num_intervals));
-  GatherResultsToRoot(local_chars, counts, displs, world_rank_, world_size_, characteristics);
-
-  MPI_Bcast(characteristics.data(), num_intervals, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  ppc::comm::Allgatherv(local_chars.data(), characteristics.data(), char_plan, GetComm());
 }
 
 int DergachevAMultistep2dParallelMPI::SelectBestInterval(const std::vector<double> &characteristics) {
@@ -334,17 +279,17 @@ double DergachevAMultistep2dParallelMPI::PerformTrial(double t) {
 
 void DergachevAMultistep2dParallelMPI::BroadcastTrialData() {
   int size = static_cast<int>(t_values_.size());
-  MPI_Bcast(&size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&size, 1, MPI_INT, 0, GetComm());
 
-  if (world_rank_ != 0) {
+  if (rank_ != 0) {
     t_values_.resize(static_cast<std::size_t>(size));
     trials_.resize(static_cast<std::size_t>(size));
   }
 
-  MPI_Bcast(t_values_.data(), size, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  MPI_Bcast(t_values_.data(), size, MPI_DOUBLE, 0, GetComm());
 
   std::vector<double> trial_data(static_cast<std::size_t>(size) * 3);
-  if (world_rank_ == 0) {
+  if (rank_ == 0) {
     for (int i = 0; i < size; ++i) {
       auto idx = static_cast<std::size_t>(i);
       trial_data[(idx * 3)] = trials_[idx].x;
@@ -353,9 +298,9 @@ void DergachevAMultistep2dParallelMPI::BroadcastTrialData() {
     }
   }
 
-  MPI_Bcast(trial_data.data(), size * 3, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  MPI_Bcast(trial_data.data(), size * 3, MPI_DOUBLE, 0, GetComm());
 
-  if (world_rank_ != 0) {
+  if (rank_ != 0) {
     for (int i = 0; i < size; ++i) {
       auto idx = static_cast<std::size_t>(i);
       trials_[idx].x = trial_data[(idx * 3)];
@@ -10,13 +10,18 @@ class DergachevASimpleIterationMethodMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit DergachevASimpleIterationMethodMPI(const InType &in);
+  static constexpr bool kUsesTaskComm = true;
+  /// Steps between two residual checks by default
+  static constexpr int kDefaultCheckInterval = 4;
+  explicit DergachevASimpleIterationMethodMPI(const InType &in, int check_interval = kDefaultCheckInterval);
 
  private:
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+
+  int check_interval_ = kDefaultCheckInterval;
 };
 
 }  // namespace dergachev_a_simple_iteration_method
@@ -2,35 +2,19 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <vector>
 
+#include "comm/include/collectives.hpp"
+#include "comm/include/partition.hpp"
 #include "dergachev_a_simple_iteration_method/common/include/common.hpp"
 
 namespace dergachev_a_simple_iteration_method {
 
 namespace {
 
-void ComputeRowDistribution(int n, int size, std::vector<int> &row_counts, std::vector<int> &row_displs,
-                            std::vector<int> &matrix_counts, std::vector<int> &matrix_displs) {
-  int row_offset = 0;
-  int matrix_offset = 0;
-  for (int proc = 0; proc < size; proc++) {
-    int base_rows = n / size;
-    int extra = (proc < (n % size)) ? 1 : 0;
-    int proc_rows = base_rows + extra;
-
-    row_counts[proc] = proc_rows;
-    row_displs[proc] = row_offset;
-    matrix_counts[proc] = proc_rows * n;
-    matrix_displs[proc] = matrix_offset;
-
-    row_offset += proc_rows;
-    matrix_offset += proc_rows * n;
-  }
-}
-
 int ComputeFinalResult(const std::vector<double> &x, int n) {
   double sum = 0.0;
   for (int i = 0; i < n; i++) {
@@ -59,47 +43,25 @@ void ComputeLocalProduct(const std::vector<double> &local_matrix, const std::vec
   }
 }
 
-void GatherResults(const std::vector<double> &local_x_new, std::vector<double> &x_new,
-                   const std::vector<int> &row_counts, const std::vector<int> &row_displs, int rank, int size,
-                   int local_rows, int start_row) {
-  if (rank == 0) {
-    for (int i = 0; i < local_rows; i++) {
-      x_new[start_row + i] = local_x_new[i];
-    }
-    for (int proc = 1; proc < size; proc++) {
-      MPI_Recv(x_new.data() + row_displs[proc], row_counts[proc], MPI_DOUBLE, proc, 0, MPI_COMM_WORLD,
-               MPI_STATUS_IGNORE);
-    }
-  } else {
-    MPI_Send(local_x_new.data(), local_rows, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-  }
-}
-
-double ComputeLocalDiff(const std::vector<double> &x_new, const std::vector<double> &x, int local_rows, int start_row) {
+double ComputeLocalDiff(const std::vector<double> &local_x_new, const std::vector<double> &x, int local_rows,
+                        int start_row) {
   double local_diff = 0.0;
   for (int i = 0; i < local_rows; i++) {
-    double d = x_new[start_row + i] - x[start_row + i];
+    double d = local_x_new[i] - x[start_row + i];
     local_diff += d * d;
   }
   return local_diff;
 }
 
-int CheckConvergence(double local_diff, double epsilon, int rank) {
-  double global_diff = 0.0;
-  MPI_Reduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-
-  int converged = 0;
-  if (rank == 0) {
-    global_diff = std::sqrt(global_diff);
-    converged = (global_diff < epsilon) ? 1 : 0;
-  }
-  MPI_Bcast(&converged, 1, MPI_INT, 0, MPI_COMM_WORLD);
-  return converged;
+void MergeRemoteRows(const std::vector<double> &gathered, std::vector<double> &x, int local_rows, int start_row) {
+  std::copy(gathered.begin(), gathered.begin() + start_row, x.begin());
+  std::copy(gathered.begin() + start_row + local_rows, gathered.end(), x.begin() + start_row + local_rows);
 }
 
 }  // namespace
 
-DergachevASimpleIterationMethodMPI::DergachevASimpleIterationMethodMPI(const InType &in) {
+DergachevASimpleIterationMethodMPI::DergachevASimpleIterationMethodMPI(const InType &in, int check_interval)
+    : check_interval_(check_interval) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
   GetOutput() = 0;
@@ -107,13 +69,13 @@ DergachevASimpleIterationMethodMPI::DergachevASimpleIterationMethodMPI(const InT
 
 bool DergachevASimpleIterationMethodMPI::ValidationImpl() {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetComm(), &rank);
 
   int is_valid = 0;
   if (rank == 0) {
-    is_valid = ((GetInput() > 0) && (GetOutput() == 0)) ? 1 : 0;
+    is_valid = ((GetInput() > 0) && (GetOutput() == 0) && (check_interval_ > 0)) ? 1 : 0;
   }
-  MPI_Bcast(&is_valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&is_valid, 1, MPI_INT, 0, GetComm());
 
   return is_valid != 0;
 }
@@ -121,8 +83,8 @@ bool DergachevASimpleIterationMethodMPI::ValidationImpl() {
 bool DergachevASimpleIterationMethodMPI::PreProcessingImpl() {
   int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
   if (size < 1) {
     return false;
@@ -130,7 +92,7 @@ bool DergachevASimpleIterationMethodMPI::PreProcessingImpl() {
 
   GetOutput() = 0;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(GetComm());
   return true;
 }
 
@@ -142,17 +104,14 @@ bool DergachevASimpleIterationMethodMPI::RunImpl() {
 
   int rank = 0;
   int size = 1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
+  const auto &row_plan = ppc::comm::GetBlockPlan(n, size);
+  const auto &matrix_plan = ppc::comm::GetBlockPlan(n, size, n);
 
-  int local_rows = row_counts[rank];
-  int start_row = row_displs[rank];
+  const auto local_rows = static_cast<int>(row_plan.GetCount(rank));
+  const auto start_row = static_cast<int>(row_plan.GetDispl(rank));
 
   std::vector<double> flat_matrix;
   std::vector<double> b;
@@ -163,40 +122,62 @@ bool DergachevASimpleIterationMethodMPI::RunImpl() {
   }
 
   std::vector<double> local_matrix(static_cast<std::size_t>(local_rows) * n, 0.0);
-  MPI_Scatterv(flat_matrix.data(), matrix_counts.data(), matrix_displs.data(), MPI_DOUBLE, local_matrix.data(),
-               local_rows * n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  ppc::comm::Scatterv(flat_matrix.data(), local_matrix.data(), matrix_plan, 0, GetComm());
 
   std::vector<double> local_b(local_rows, 0.0);
-  MPI_Scatterv(b.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_b.data(), local_rows, MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  ppc::comm::Scatterv(b.data(), local_b.data(), row_plan, 0, GetComm());
 
   const double tau = 0.5;
   const double epsilon = 1e-6;
   const int max_iterations = 1000;
 
   std::vector<double> local_x_new(local_rows, 0.0);
-  std::vector<double> x_new(n, 0.0);
+  std::vector<double> gathered(n, 0.0);
+
+  // Each step runs while the blocks of the previous one travel, so the rows of the other ranks lag one iteration
+  // behind. The residual is summed every check_interval_ steps, again in the background of the next step.
+  MPI_Request gather_request = MPI_REQUEST_NULL;
+  MPI_Request diff_request = MPI_REQUEST_NULL;
+  double local_diff = 0.0;
+  double global_diff = 0.0;
 
   for (int iteration = 0; iteration < max_iterations; iteration++) {
     ComputeLocalProduct(local_matrix, x, local_b, local_x_new, local_rows, start_row, n, tau);
-    GatherResults(local_x_new, x_new, row_counts, row_displs, rank, size, local_rows, start_row);
-    MPI_Bcast(x_new.data(), n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
-
-    double local_diff = ComputeLocalDiff(x_new, x, local_rows, start_row);
-    int converged = CheckConvergence(local_diff, epsilon, rank);
-
-    x = x_new;
+    const double step_diff = ComputeLocalDiff(local_x_new, x, local_rows, start_row);
 
-    if (converged != 0) {
+    bool converged = false;
+    if (diff_request != MPI_REQUEST_NULL) {
+      MPI_Wait(&diff_request, MPI_STATUS_IGNORE);
+      converged = std::sqrt(global_diff) < epsilon;
+    }
+    if (gather_request != MPI_REQUEST_NULL) {
+      MPI_Wait(&gather_request, MPI_STATUS_IGNORE);
+      MergeRemoteRows(gathered, x, local_rows, start_row);
+    }
+    // Own rows are the send buffer of the exchange, so they change only after it completed
+    std::ranges::copy(local_x_new, x.begin() + start_row);
+    if (converged) {
       break;
     }
+
+    if ((iteration + 1) % check_interval_ == 0) {
+      local_diff = step_diff;
+      MPI_Iallreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, GetComm(), &diff_request);
+    }
+    gather_request = ppc::comm::Iallgatherv(x.data() + start_row, gathered.data(), row_plan, GetComm());
+  }
+
+  MPI_Wait(&diff_request, MPI_STATUS_IGNORE);
+  if (gather_request != MPI_REQUEST_NULL) {
+    MPI_Wait(&gather_request, MPI_STATUS_IGNORE);
+    MergeRemoteRows(gathered, x, local_rows, start_row);
   }
 
   if (rank == 0) {
     GetOutput() = ComputeFinalResult(x, n);
   }
 
-  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, GetComm());
 
   return true;
 }
@@ -139,6 +139,25 @@ TEST(DergachevASimpleIterationMethodEdgeCases, MinimalSizeMPI) {
   EXPECT_EQ(task.GetOutput(), 1);
 }
 
+TEST(DergachevASimpleIterationMethodEdgeCases, CheckEveryIterationMPI) {
+  DergachevASimpleIterationMethodMPI task(20, 1);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), 20);
+}
+
+TEST(DergachevASimpleIterationMethodEdgeCases, CheckIntervalLongerThanIterationLimitMPI) {
+  // The residual is never checked, so all iterations run and the result still has to converge
+  DergachevASimpleIterationMethodMPI task(20, 5000);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), 20);
+}
+
 }  // namespace
 
 }  // namespace dergachev_a_simple_iteration_method
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "example_threads/common/include/common.hpp"
+#include "util/include/affinity.hpp"
 #include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_threads {
@@ -42,7 +43,10 @@ bool NesterovATestTaskSTL::RunImpl() {
 
   std::atomic<int> counter(0);
   for (int i = 0; i < num_threads; i++) {
-    threads[i] = std::thread([&]() { counter++; });
+    threads[i] = std::thread([&counter, i]() {
+      ppc::util::PinCurrentThread(i);
+      counter++;
+    });
     threads[i].join();
   }
 
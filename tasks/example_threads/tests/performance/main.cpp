@@ -1,4 +1,12 @@
 #include <gtest/gtest.h>
+#include <mpi.h>
+#include <omp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
 
 #include "example_threads/all/include/ops_all.hpp"
 #include "example_threads/common/include/common.hpp"
@@ -6,7 +14,10 @@
 #include "example_threads/seq/include/ops_seq.hpp"
 #include "example_threads/stl/include/ops_stl.hpp"
 #include "example_threads/tbb/include/ops_tbb.hpp"
+#include "util/include/clock.hpp"
+#include "util/include/mpi_threads.hpp"
 #include "util/include/perf_test_util.hpp"
+#include "util/include/util.hpp"
 
 namespace nesterov_a_test_task_threads {
 
@@ -41,4 +52,87 @@ const auto kPerfTestName = ExampleRunPerfTestThreads::CustomPerfTestName;
 
 INSTANTIATE_TEST_SUITE_P(RunModeTests, ExampleRunPerfTestThreads, kGtestValues, kPerfTestName);
 
+namespace {
+
+constexpr std::size_t kHybridChunkSize = std::size_t{1} << 15;
+constexpr int kHybridChunksPerThread = 8;
+constexpr int kHybridRepetitions = 5;
+
+// Integer-valued work keeps the sums exact, so both variants must agree bit for bit
+void FillChunk(std::vector<double> &data, int chunk, int rank) {
+  double *values = data.data() + (static_cast<std::size_t>(chunk) * kHybridChunkSize);
+  for (std::size_t i = 0; i < kHybridChunkSize; i++) {
+    int value = 0;
+    for (int k = 0; k < 64; k++) {
+      value += static_cast<int>((static_cast<std::size_t>(chunk + rank + k) + i) % 17);
+    }
+    values[i] = static_cast<double>(value);
+  }
+}
+
+// Computes every chunk first and then reduces all of them in one call from the main thread
+void ReduceAfterCompute(std::vector<double> &data, int num_chunks, int num_threads, int rank) {
+#pragma omp parallel for schedule(static, 1) num_threads(num_threads)
+  for (int chunk = 0; chunk < num_chunks; chunk++) {
+    FillChunk(data, chunk, rank);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, data.data(), static_cast<int>(data.size()), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+}
+
+// Every thread reduces its chunk on its own communicator as soon as it is ready, while the other threads compute
+void ReduceWhileComputing(std::vector<double> &data, int num_chunks, int num_threads, int rank,
+                          const ppc::util::ThreadComms &comms) {
+#pragma omp parallel num_threads(num_threads)
+  {
+    const int thread = omp_get_thread_num();
+    for (int chunk = thread; chunk < num_chunks; chunk += num_threads) {
+      FillChunk(data, chunk, rank);
+      MPI_Allreduce(MPI_IN_PLACE, data.data() + (static_cast<std::size_t>(chunk) * kHybridChunkSize),
+                    static_cast<int>(kHybridChunkSize), MPI_DOUBLE, MPI_SUM, comms.Get(thread));
+    }
+  }
+}
+
+// Median over the repetitions of the slowest rank
+template <typename Func>
+double MeasureMedian(Func &&func) {
+  std::vector<double> samples;
+  for (int rep = 0; rep < kHybridRepetitions; rep++) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double start = ppc::util::Clock::Now();
+    func();
+    double elapsed = ppc::util::Clock::Now() - start;
+    MPI_Allreduce(MPI_IN_PLACE, &elapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    samples.push_back(elapsed);
+  }
+  std::ranges::sort(samples);
+  return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+TEST(ExampleHybridPerfTest, OverlapsReductionWithCompute) {
+  if (ppc::util::GetProvidedMpiThreadLevel() < MPI_THREAD_MULTIPLE) {
+    GTEST_SKIP() << "Needs PPC_MPI_THREADS=multiple";
+  }
+  const int num_threads = ppc::util::GetNumThreads();
+  const int num_chunks = num_threads * kHybridChunksPerThread;
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  const ppc::util::ThreadComms comms(MPI_COMM_WORLD, num_threads);
+
+  std::vector<double> serial(static_cast<std::size_t>(num_chunks) * kHybridChunkSize);
+  std::vector<double> overlapped(serial.size());
+  const double serial_sec = MeasureMedian([&] { ReduceAfterCompute(serial, num_chunks, num_threads, rank); });
+  const double overlapped_sec =
+      MeasureMedian([&] { ReduceWhileComputing(overlapped, num_chunks, num_threads, rank, comms); });
+  EXPECT_EQ(serial, overlapped);
+
+  if (rank == 0) {
+    std::cout << "example_threads_hybrid:overlap:serial=" << std::fixed << std::setprecision(10) << serial_sec
+              << ",overlapped=" << overlapped_sec << std::setprecision(4)
+              << ",speedup=" << (overlapped_sec > 0.0 ? serial_sec / overlapped_sec : 0.0) << '\n';
+  }
+}
+
 }  // namespace nesterov_a_test_task_threads
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 
+#include "comm/include/serializer.hpp"
 #include "galkin_d_trapezoid_method/common/include/common.hpp"
 
 namespace galkin_d_trapezoid_method {
@@ -32,7 +33,7 @@ bool GalkinDTrapezoidMethodMPI::RunImpl() {
 
   InType in = (rank == 0) ? GetInput() : InType{};
 
-  MPI_Bcast(&in, sizeof(InType), MPI_BYTE, 0, MPI_COMM_WORLD);
+  ppc::comm::Broadcast(in, 0, MPI_COMM_WORLD);
 
   GetInput() = in;
 
@@ -12,7 +12,10 @@ class KlimenkoVSeidelMethodMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
-  explicit KlimenkoVSeidelMethodMPI(const InType &in);
+  static constexpr bool kUsesTaskComm = true;
+  /// Sweeps between two residual checks by default
+  static constexpr int kDefaultCheckInterval = 4;
+  explicit KlimenkoVSeidelMethodMPI(const InType &in, int check_interval = kDefaultCheckInterval);
 
   bool ValidationImpl() override;
   bool PreProcessingImpl() override;
@@ -21,14 +24,17 @@ class KlimenkoVSeidelMethodMPI : public BaseTask {
 
   static int ComputeFinalResult(const std::vector<double> &x, int n);
   static void InitializeMatrixAndVector(std::vector<double> &flat_matrix, std::vector<double> &b, int n);
-  static void ComputeRowDistribution(int n, int size, std::vector<int> &row_counts, std::vector<int> &row_displs,
-                                     std::vector<int> &matrix_counts, std::vector<int> &matrix_displs);
   static void PerformSeidelIteration(int local_rows, int start_row, int n, const std::vector<double> &local_matrix,
                                      const std::vector<double> &local_b, std::vector<double> &x);
   static double ComputeLocalDifference(int local_rows, int start_row, const std::vector<double> &x,
                                        const std::vector<double> &x_old);
   static void UpdateLocalXVector(int local_rows, int start_row, const std::vector<double> &x,
                                  std::vector<double> &local_x_updated);
+  static void MergeRemoteRows(int local_rows, int start_row, const std::vector<double> &gathered,
+                              std::vector<double> &x);
+
+ private:
+  int check_interval_ = kDefaultCheckInterval;
 };
 
 }  // namespace klimenko_v_seidel_method
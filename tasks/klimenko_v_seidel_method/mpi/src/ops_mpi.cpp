@@ -2,17 +2,21 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <cstddef>
 #include <random>
 #include <vector>
 
+#include "comm/include/collectives.hpp"
+#include "comm/include/partition.hpp"
 #include "klimenko_v_seidel_method/common/include/common.hpp"
 
 namespace klimenko_v_seidel_method {
 
-KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in) {
+KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in, int check_interval)
+    : check_interval_(check_interval) {
   SetTypeOfTask(GetStaticTypeOfTask());
   GetInput() = in;
   GetOutput() = 0;
@@ -20,13 +24,13 @@ KlimenkoVSeidelMethodMPI::KlimenkoVSeidelMethodMPI(const InType &in) {
 
 bool KlimenkoVSeidelMethodMPI::ValidationImpl() {
   int rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_rank(GetComm(), &rank);
 
   int is_valid = 0;
   if (rank == 0) {
-    is_valid = ((GetInput() > 0) && (GetOutput() == 0)) ? 1 : 0;
+    is_valid = ((GetInput() > 0) && (GetOutput() == 0) && (check_interval_ > 0)) ? 1 : 0;
   }
-  MPI_Bcast(&is_valid, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&is_valid, 1, MPI_INT, 0, GetComm());
 
   return is_valid != 0;
 }
@@ -34,12 +38,12 @@ bool KlimenkoVSeidelMethodMPI::ValidationImpl() {
 bool KlimenkoVSeidelMethodMPI::PreProcessingImpl() {
   int rank = 0;
   int size = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
   GetOutput() = 0;
 
-  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(GetComm());
   return true;
 }
 
@@ -48,17 +52,14 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
 
   int rank = 0;
   int size = 1;
-  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(GetComm(), &rank);
+  MPI_Comm_size(GetComm(), &size);
 
-  std::vector<int> row_counts(size);
-  std::vector<int> row_displs(size);
-  std::vector<int> matrix_counts(size);
-  std::vector<int> matrix_displs(size);
-  ComputeRowDistribution(n, size, row_counts, row_displs, matrix_counts, matrix_displs);
+  const auto &row_plan = ppc::comm::GetBlockPlan(n, size);
+  const auto &matrix_plan = ppc::comm::GetBlockPlan(n, size, n);
 
-  int local_rows = row_counts[rank];
-  int start_row = row_displs[rank];
+  const auto local_rows = static_cast<int>(row_plan.GetCount(rank));
+  const auto start_row = static_cast<int>(row_plan.GetDispl(rank));
 
   std::vector<double> flat_matrix;
   std::vector<double> b;
@@ -67,43 +68,62 @@ bool KlimenkoVSeidelMethodMPI::RunImpl() {
   }
 
   std::vector<double> local_matrix(static_cast<size_t>(local_rows) * n, 0.0);
-  MPI_Scatterv(flat_matrix.data(), matrix_counts.data(), matrix_displs.data(), MPI_DOUBLE, local_matrix.data(),
-               local_rows * n, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  ppc::comm::Scatterv(flat_matrix.data(), local_matrix.data(), matrix_plan, 0, GetComm());
 
   std::vector<double> local_b(local_rows, 0.0);
-  MPI_Scatterv(b.data(), row_counts.data(), row_displs.data(), MPI_DOUBLE, local_b.data(), local_rows, MPI_DOUBLE, 0,
-               MPI_COMM_WORLD);
+  ppc::comm::Scatterv(b.data(), local_b.data(), row_plan, 0, GetComm());
 
   std::vector<double> x(n, 0.0);
+  std::vector<double> x_old(n, 0.0);
+  std::vector<double> gathered(n, 0.0);
+  std::vector<double> local_x_updated(local_rows);
   const double epsilon = 1e-6;
   const int max_iterations = 1000;
 
+  // Each sweep runs while the blocks of the previous one travel, so the rows of the other ranks lag one iteration
+  // behind. The residual is summed every check_interval_ sweeps, again in the background of the next sweep.
+  MPI_Request gather_request = MPI_REQUEST_NULL;
+  MPI_Request diff_request = MPI_REQUEST_NULL;
+  double local_diff = 0.0;
+  double global_diff = 0.0;
+
   for (int iteration = 0; iteration < max_iterations; iteration++) {
-    std::vector<double> x_old = x;
+    x_old = x;
 
     PerformSeidelIteration(local_rows, start_row, n, local_matrix, local_b, x);
 
-    std::vector<double> local_x_updated(local_rows);
-    UpdateLocalXVector(local_rows, start_row, x, local_x_updated);
-
-    MPI_Allgatherv(local_x_updated.data(), local_rows, MPI_DOUBLE, x.data(), row_counts.data(), row_displs.data(),
-                   MPI_DOUBLE, MPI_COMM_WORLD);
-
-    double local_diff = ComputeLocalDifference(local_rows, start_row, x, x_old);
-    double global_diff = 0.0;
-    MPI_Allreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    global_diff = std::sqrt(global_diff);
-
-    if (global_diff < epsilon) {
+    bool converged = false;
+    if (diff_request != MPI_REQUEST_NULL) {
+      MPI_Wait(&diff_request, MPI_STATUS_IGNORE);
+      converged = std::sqrt(global_diff) < epsilon;
+    }
+    if (gather_request != MPI_REQUEST_NULL) {
+      MPI_Wait(&gather_request, MPI_STATUS_IGNORE);
+      MergeRemoteRows(local_rows, start_row, gathered, x);
+    }
+    if (converged) {
       break;
     }
+
+    if ((iteration + 1) % check_interval_ == 0) {
+      local_diff = ComputeLocalDifference(local_rows, start_row, x, x_old);
+      MPI_Iallreduce(&local_diff, &global_diff, 1, MPI_DOUBLE, MPI_SUM, GetComm(), &diff_request);
+    }
+    UpdateLocalXVector(local_rows, start_row, x, local_x_updated);
+    gather_request = ppc::comm::Iallgatherv(local_x_updated.data(), gathered.data(), row_plan, GetComm());
+  }
+
+  MPI_Wait(&diff_request, MPI_STATUS_IGNORE);
+  if (gather_request != MPI_REQUEST_NULL) {
+    MPI_Wait(&gather_request, MPI_STATUS_IGNORE);
+    MergeRemoteRows(local_rows, start_row, gathered, x);
   }
 
   if (rank == 0) {
     GetOutput() = ComputeFinalResult(x, n);
   }
 
-  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast(&GetOutput(), 1, MPI_INT, 0, GetComm());
   return true;
 }
 
@@ -111,26 +131,6 @@ bool KlimenkoVSeidelMethodMPI::PostProcessingImpl() {
   return GetOutput() > 0;
 }
 
-void KlimenkoVSeidelMethodMPI::ComputeRowDistribution(int n, int size, std::vector<int> &row_counts,
-                                                      std::vector<int> &row_displs, std::vector<int> &matrix_counts,
-                                                      std::vector<int> &matrix_displs) {
-  int row_offset = 0;
-  int matrix_offset = 0;
-  for (int proc = 0; proc < size; proc++) {
-    int base_rows = n / size;
-    int extra = (proc < (n % size)) ? 1 : 0;
-    int proc_rows = base_rows + extra;
-
-    row_counts[proc] = proc_rows;
-    row_displs[proc] = row_offset;
-    matrix_counts[proc] = proc_rows * n;
-    matrix_displs[proc] = matrix_offset;
-
-    row_offset += proc_rows;
-    matrix_offset += proc_rows * n;
-  }
-}
-
 int KlimenkoVSeidelMethodMPI::ComputeFinalResult(const std::vector<double> &x, int n) {
   double sum = 0.0;
   for (int i = 0; i < n; i++) {
@@ -202,6 +202,12 @@ void KlimenkoVSeidelMethodMPI::UpdateLocalXVector(int local_rows, int start_row,
   }
 }
 
+void KlimenkoVSeidelMethodMPI::MergeRemoteRows(int local_rows, int start_row, const std::vector<double> &gathered,
+                                               std::vector<double> &x) {
+  std::copy(gathered.begin(), gathered.begin() + start_row, x.begin());
+  std::copy(gathered.begin() + start_row + local_rows, gathered.end(), x.begin() + start_row + local_rows);
+}
+
 double KlimenkoVSeidelMethodMPI::ComputeLocalDifference(int local_rows, int start_row, const std::vector<double> &x,
                                                         const std::vector<double> &x_old) {
   double local_diff = 0.0;
@@ -59,6 +59,25 @@ const auto kPerfTestName = KlimenkoVSeidelMethodFuncTests::PrintFuncTestName<Kli
 
 INSTANTIATE_TEST_SUITE_P(MatrixFuncTests, KlimenkoVSeidelMethodFuncTests, kGtestValues, kPerfTestName);
 
+TEST(KlimenkoVSeidelMethodCheckInterval, CheckEveryIterationMPI) {
+  KlimenkoVSeidelMethodMPI task(20, 1);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), 20);
+}
+
+TEST(KlimenkoVSeidelMethodCheckInterval, CheckIntervalLongerThanIterationLimitMPI) {
+  // The residual is never checked, so all iterations run and the result still has to converge
+  KlimenkoVSeidelMethodMPI task(20, 5000);
+  EXPECT_TRUE(task.Validation());
+  EXPECT_TRUE(task.PreProcessing());
+  EXPECT_TRUE(task.Run());
+  EXPECT_TRUE(task.PostProcessing());
+  EXPECT_EQ(task.GetOutput(), 20);
+}
+
 }  // namespace
 
 }  // namespace klimenko_v_seidel_method
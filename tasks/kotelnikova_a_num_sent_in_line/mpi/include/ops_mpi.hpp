@@ -1,7 +1,8 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 
+#include "comm/include/shared_buffer.hpp"
 #include "kotelnikova_a_num_sent_in_line/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -20,9 +21,11 @@ class KotelnikovaANumSentInLineMPI : public BaseTask {
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  static int CountLocalSentences(const std::string &text, int start, int end, int total_length);
-  static bool BorderControl(const std::string &text, int start);
-  static void ProcessingPart(const std::string &text, int start, int end, int &local_count, bool &local_in_sentence);
+  static int CountLocalSentences(std::string_view text, int start, int end, int total_length);
+  static bool BorderControl(std::string_view text, int start);
+  static void ProcessingPart(std::string_view text, int start, int end, int &local_count, bool &local_in_sentence);
+
+  ppc::comm::SharedBuffer<char> shared_text_;
 };
 
 }  // namespace kotelnikova_a_num_sent_in_line
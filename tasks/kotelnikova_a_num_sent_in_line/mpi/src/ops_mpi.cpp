@@ -5,8 +5,10 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
-#include <string>
+#include <span>
+#include <string_view>
 
+#include "comm/include/shared_buffer.hpp"
 #include "kotelnikova_a_num_sent_in_line/common/include/common.hpp"
 
 namespace kotelnikova_a_num_sent_in_line {
@@ -22,6 +24,8 @@ bool KotelnikovaANumSentInLineMPI::ValidationImpl() {
 }
 
 bool KotelnikovaANumSentInLineMPI::PreProcessingImpl() {
+  // One copy of the text per node instead of one per rank, allocated once and refilled by every run
+  shared_text_ = ppc::comm::SharedBuffer<char>::AllocateFromRoot(GetInput().size(), 0, MPI_COMM_WORLD);
   return true;
 }
 
@@ -31,19 +35,9 @@ bool KotelnikovaANumSentInLineMPI::RunImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &world_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
 
-  int total_length = 0;
-  if (world_rank == 0) {
-    total_length = static_cast<int>(GetInput().length());
-  }
-  MPI_Bcast(&total_length, 1, MPI_INT, 0, MPI_COMM_WORLD);
-
-  std::string text;
-  if (world_rank == 0) {
-    text = GetInput();
-  } else {
-    text.resize(static_cast<std::size_t>(total_length));
-  }
-  MPI_Bcast(text.data(), total_length, MPI_CHAR, 0, MPI_COMM_WORLD);
+  shared_text_.Assign(std::span<const char>(GetInput()), 0);
+  const std::string_view text(shared_text_.GetSpan().data(), shared_text_.GetCount());
+  const auto total_length = static_cast<int>(text.size());
 
   int chunk_size = total_length / world_size;
   int remainder = total_length % world_size;
@@ -60,7 +54,7 @@ bool KotelnikovaANumSentInLineMPI::RunImpl() {
   return true;
 }
 
-int KotelnikovaANumSentInLineMPI::CountLocalSentences(const std::string &text, int start, int end, int total_length) {
+int KotelnikovaANumSentInLineMPI::CountLocalSentences(std::string_view text, int start, int end, int total_length) {
   int local_count = 0;
   bool local_in_sentence = false;
 
@@ -77,7 +71,7 @@ int KotelnikovaANumSentInLineMPI::CountLocalSentences(const std::string &text, i
   return local_count;
 }
 
-bool KotelnikovaANumSentInLineMPI::BorderControl(const std::string &text, int start) {
+bool KotelnikovaANumSentInLineMPI::BorderControl(std::string_view text, int start) {
   int pos = start - 1;
   while (pos >= 0) {
     char c = text[static_cast<std::size_t>(pos)];
@@ -92,7 +86,7 @@ bool KotelnikovaANumSentInLineMPI::BorderControl(const std::string &text, int st
   return false;
 }
 
-void KotelnikovaANumSentInLineMPI::ProcessingPart(const std::string &text, int start, int end, int &local_count,
+void KotelnikovaANumSentInLineMPI::ProcessingPart(std::string_view text, int start, int end, int &local_count,
                                                   bool &local_in_sentence) {
   for (int i = start; i < end; ++i) {
     char c = text[static_cast<std::size_t>(i)];
@@ -111,6 +105,7 @@ void KotelnikovaANumSentInLineMPI::ProcessingPart(const std::string &text, int s
 }
 
 bool KotelnikovaANumSentInLineMPI::PostProcessingImpl() {
+  shared_text_ = {};
   return true;
 }
 
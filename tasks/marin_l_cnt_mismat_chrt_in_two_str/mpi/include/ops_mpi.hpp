@@ -1,7 +1,8 @@
 #pragma once
 
-#include <string>
+#include <cstddef>
 
+#include "comm/include/shared_buffer.hpp"
 #include "marin_l_cnt_mismat_chrt_in_two_str/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -19,8 +20,8 @@ class MarinLCntMismatChrtInTwoStrMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
-  std::string local_s1_;
-  std::string local_s2_;
+  ppc::comm::SharedBuffer<char> shared_text_;
+  std::size_t len1_ = 0;
 };
 
 }  // namespace marin_l_cnt_mismat_chrt_in_two_str
@@ -5,9 +5,10 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
-#include <string>
+#include <string_view>
 #include <utility>
 
+#include "comm/include/shared_buffer.hpp"
 #include "marin_l_cnt_mismat_chrt_in_two_str/common/include/common.hpp"
 
 namespace marin_l_cnt_mismat_chrt_in_two_str {
@@ -29,28 +30,21 @@ bool MarinLCntMismatChrtInTwoStrMPI::PreProcessingImpl() {
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   std::array<int, 2> lengths{};
-  std::string s1_local;
-  std::string s2_local;
-
   if (rank == 0) {
-    s1_local = GetInput().first;
-    s2_local = GetInput().second;
-    lengths[0] = static_cast<int>(s1_local.size());
-    lengths[1] = static_cast<int>(s2_local.size());
+    lengths[0] = static_cast<int>(GetInput().first.size());
+    lengths[1] = static_cast<int>(GetInput().second.size());
   }
-
   MPI_Bcast(lengths.data(), 2, MPI_INT, 0, MPI_COMM_WORLD);
+  len1_ = static_cast<std::size_t>(lengths[0]);
 
-  if (rank != 0) {
-    s1_local.resize(lengths[0]);
-    s2_local.resize(lengths[1]);
+  // Both strings back to back, one copy per node instead of one per rank
+  shared_text_ = ppc::comm::SharedBuffer<char>(len1_ + static_cast<std::size_t>(lengths[1]), MPI_COMM_WORLD);
+  if (rank == 0) {
+    auto text = shared_text_.GetMutableSpan();
+    std::ranges::copy(GetInput().first, text.begin());
+    std::ranges::copy(GetInput().second, text.begin() + static_cast<std::ptrdiff_t>(len1_));
   }
-
-  MPI_Bcast(s1_local.data(), lengths[0], MPI_CHAR, 0, MPI_COMM_WORLD);
-  MPI_Bcast(s2_local.data(), lengths[1], MPI_CHAR, 0, MPI_COMM_WORLD);
-
-  local_s1_ = std::move(s1_local);
-  local_s2_ = std::move(s2_local);
+  shared_text_.Publish(0);
 
   GetOutput() = 0;
   return true;
@@ -62,8 +56,9 @@ bool MarinLCntMismatChrtInTwoStrMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  const std::string &s1 = local_s1_;
-  const std::string &s2 = local_s2_;
+  const std::string_view text(shared_text_.GetSpan().data(), shared_text_.GetCount());
+  const std::string_view s1 = text.substr(0, len1_);
+  const std::string_view s2 = text.substr(len1_);
 
   std::size_t len1 = s1.size();
   std::size_t len2 = s2.size();
@@ -100,6 +95,7 @@ bool MarinLCntMismatChrtInTwoStrMPI::RunImpl() {
 }
 
 bool MarinLCntMismatChrtInTwoStrMPI::PostProcessingImpl() {
+  shared_text_ = {};
   return true;
 }
 
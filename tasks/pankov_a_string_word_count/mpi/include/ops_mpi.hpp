@@ -1,5 +1,6 @@
 #pragma once
 
+#include "comm/include/shared_buffer.hpp"
 #include "pankov_a_string_word_count/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -17,6 +18,8 @@ class PankovAStringWordCountMPI : public BaseTask {
   bool PreProcessingImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
+
+  ppc::comm::SharedBuffer<char> shared_text_;
 };
 
 }  // namespace pankov_a_string_word_count
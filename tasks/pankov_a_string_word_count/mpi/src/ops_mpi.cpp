@@ -5,9 +5,11 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
-#include <string>
+#include <span>
+#include <string_view>
 #include <utility>
 
+#include "comm/include/shared_buffer.hpp"
 #include "pankov_a_string_word_count/common/include/common.hpp"
 
 namespace pankov_a_string_word_count {
@@ -23,13 +25,15 @@ bool PankovAStringWordCountMPI::ValidationImpl() {
 }
 
 bool PankovAStringWordCountMPI::PreProcessingImpl() {
+  // One copy of the string per node instead of one per rank, allocated once and refilled by every run
+  shared_text_ = ppc::comm::SharedBuffer<char>::AllocateFromRoot(GetInput().size(), 0, MPI_COMM_WORLD);
   GetOutput() = 0;
   return true;
 }
 
 namespace {
 
-int CountWordsLocal(const std::string &s, std::size_t start, std::size_t end) {
+int CountWordsLocal(std::string_view s, std::size_t start, std::size_t end) {
   int count = 0;
   bool in_word = false;
 
@@ -56,26 +60,16 @@ bool PankovAStringWordCountMPI::RunImpl() {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
-  std::string s;
-  int n = 0;
-  if (rank == 0) {
-    s = GetInput();
-    n = static_cast<int>(s.size());
-  }
-  MPI_Bcast(&n, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  shared_text_.Assign(std::span<const char>(GetInput()), 0);
+  const std::string_view s(shared_text_.GetSpan().data(), shared_text_.GetCount());
 
-  if (n == 0) {
+  if (s.empty()) {
     GetOutput() = 0;
     MPI_Barrier(MPI_COMM_WORLD);
     return true;
   }
 
-  if (rank != 0) {
-    s.resize(static_cast<std::size_t>(n));
-  }
-  MPI_Bcast(s.data(), n, MPI_CHAR, 0, MPI_COMM_WORLD);
-
-  const auto str_size = static_cast<std::size_t>(n);
+  const std::size_t str_size = s.size();
   std::size_t base = str_size / static_cast<std::size_t>(size);
   std::size_t rem = str_size % static_cast<std::size_t>(size);
 
@@ -114,6 +108,7 @@ bool PankovAStringWordCountMPI::RunImpl() {
 }
 
 bool PankovAStringWordCountMPI::PostProcessingImpl() {
+  shared_text_ = {};
   return GetOutput() >= 0;
 }
 
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
+#include "comm/include/shared_buffer.hpp"
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 #include "task/include/task.hpp"
 
@@ -23,10 +25,10 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
   bool RunSequential();
 
   bool PrepareAndValidateSizes(int &rows_a, int &cols_a, int &rows_b, int &cols_b);
-  void PrepareAndBroadcastMatrixB(std::vector<double> &b_flat, int rows_b, int cols_b);
+  void PrepareAndBroadcastMatrixB(ppc::comm::SharedBuffer<double> &b_flat, int rows_b, int cols_b);
   void DistributeMatrixAData(std::vector<int> &my_row_indices, std::vector<double> &local_a_flat, int &local_rows,
                              int rows_a, int cols_a);
-  static void ComputeLocalMultiplication(const std::vector<double> &local_a_flat, const std::vector<double> &b_flat,
+  static void ComputeLocalMultiplication(const std::vector<double> &local_a_flat, std::span<const double> b_flat,
                                          std::vector<double> &local_result_flat, int local_rows, int cols_a,
                                          int cols_b);
   void GatherResults(std::vector<double> &final_result_flat, const std::vector<int> &my_row_indices,
@@ -50,6 +52,12 @@ class SosninaAMatrixMultHorizontalMPI : public BaseTask {
   std::vector<std::vector<double>> result_matrix_;
   int rank_ = 0;
   int world_size_ = 1;
+  int rows_a_ = 0;
+  int cols_a_ = 0;
+  int rows_b_ = 0;
+  int cols_b_ = 0;
+  bool sizes_valid_ = false;
+  ppc::comm::SharedBuffer<double> b_flat_;
 };
 
 }  // namespace sosnina_a_matrix_mult_horizontal
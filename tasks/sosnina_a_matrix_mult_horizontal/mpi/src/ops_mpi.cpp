@@ -5,8 +5,10 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <span>
 #include <vector>
 
+#include "comm/include/shared_buffer.hpp"
 #include "sosnina_a_matrix_mult_horizontal/common/include/common.hpp"
 
 namespace sosnina_a_matrix_mult_horizontal {
@@ -47,6 +49,14 @@ bool SosninaAMatrixMultHorizontalMPI::PreProcessingImpl() {
   world_size_ = size;
   GetOutput() = std::vector<std::vector<double>>();
 
+  sizes_valid_ = world_size_ > 1 && PrepareAndValidateSizes(rows_a_, cols_a_, rows_b_, cols_b_);
+  if (sizes_valid_) {
+    // B is only read, so every node keeps a single copy that all of its ranks share; the window is allocated once
+    // here and refilled by every run
+    b_flat_ =
+        ppc::comm::SharedBuffer<double>(static_cast<size_t>(rows_b_) * static_cast<size_t>(cols_b_), MPI_COMM_WORLD);
+  }
+
   return true;
 }
 
@@ -55,30 +65,24 @@ bool SosninaAMatrixMultHorizontalMPI::RunImpl() {
     return RunSequential();
   }
 
-  int rows_a = 0;
-  int cols_a = 0;
-  int rows_b = 0;
-  int cols_b = 0;
-
-  if (!PrepareAndValidateSizes(rows_a, cols_a, rows_b, cols_b)) {
+  if (!sizes_valid_) {
     return true;
   }
 
-  std::vector<double> b_flat(static_cast<size_t>(rows_b) * static_cast<size_t>(cols_b));
-  PrepareAndBroadcastMatrixB(b_flat, rows_b, cols_b);
+  PrepareAndBroadcastMatrixB(b_flat_, rows_b_, cols_b_);
 
   std::vector<int> my_row_indices;
   std::vector<double> local_a_flat;
   int local_rows = 0;
-  DistributeMatrixAData(my_row_indices, local_a_flat, local_rows, rows_a, cols_a);
+  DistributeMatrixAData(my_row_indices, local_a_flat, local_rows, rows_a_, cols_a_);
 
-  std::vector<double> local_result_flat(static_cast<size_t>(local_rows) * static_cast<size_t>(cols_b), 0.0);
-  ComputeLocalMultiplication(local_a_flat, b_flat, local_result_flat, local_rows, cols_a, cols_b);
+  std::vector<double> local_result_flat(static_cast<size_t>(local_rows) * static_cast<size_t>(cols_b_), 0.0);
+  ComputeLocalMultiplication(local_a_flat, b_flat_.GetSpan(), local_result_flat, local_rows, cols_a_, cols_b_);
 
   std::vector<double> final_result_flat;
-  GatherResults(final_result_flat, my_row_indices, local_result_flat, local_rows, rows_a, cols_b);
+  GatherResults(final_result_flat, my_row_indices, local_result_flat, local_rows, rows_a_, cols_b_);
 
-  ConvertToMatrix(final_result_flat, rows_a, cols_b);
+  ConvertToMatrix(final_result_flat, rows_a_, cols_b_);
 
   return true;
 }
@@ -139,16 +143,18 @@ bool SosninaAMatrixMultHorizontalMPI::PrepareAndValidateSizes(int &rows_a, int &
   return true;
 }
 
-void SosninaAMatrixMultHorizontalMPI::PrepareAndBroadcastMatrixB(std::vector<double> &b_flat, int rows_b, int cols_b) {
+void SosninaAMatrixMultHorizontalMPI::PrepareAndBroadcastMatrixB(ppc::comm::SharedBuffer<double> &b_flat, int rows_b,
+                                                                 int cols_b) {
   if (rank_ == 0) {
+    auto b_data = b_flat.GetMutableSpan();
     for (int i = 0; i < rows_b; ++i) {
       for (int j = 0; j < cols_b; ++j) {
-        b_flat[(static_cast<size_t>(i) * static_cast<size_t>(cols_b)) + static_cast<size_t>(j)] = matrix_B_[i][j];
+        b_data[(static_cast<size_t>(i) * static_cast<size_t>(cols_b)) + static_cast<size_t>(j)] = matrix_B_[i][j];
       }
     }
   }
 
-  MPI_Bcast(b_flat.data(), rows_b * cols_b, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  b_flat.Publish(0);
 }
 
 void SosninaAMatrixMultHorizontalMPI::FillLocalAFlat(const std::vector<int> &my_row_indices,
@@ -293,7 +299,7 @@ void SosninaAMatrixMultHorizontalMPI::GatherResults(std::vector<double> &final_r
 }
 
 void SosninaAMatrixMultHorizontalMPI::ComputeLocalMultiplication(const std::vector<double> &local_a_flat,
-                                                                 const std::vector<double> &b_flat,
+                                                                 std::span<const double> b_flat,
                                                                  std::vector<double> &local_result_flat, int local_rows,
                                                                  int cols_a, int cols_b) {
   for (int i = 0; i < local_rows; ++i) {
@@ -326,6 +332,7 @@ void SosninaAMatrixMultHorizontalMPI::ConvertToMatrix(const std::vector<double>
 }
 
 bool SosninaAMatrixMultHorizontalMPI::PostProcessingImpl() {
+  b_flat_ = {};
   return true;
 }
 
@@ -3,12 +3,11 @@
 #include <mpi.h>
 
 #include <algorithm>
-#include <array>
 #include <cstddef>
 #include <tuple>
-#include <utility>
 #include <vector>
 
+#include "comm/include/serializer.hpp"
 #include "trofimov_n_max_val_matrix/common/include/common.hpp"
 
 namespace trofimov_n_max_val_matrix {
@@ -110,54 +109,14 @@ void GatherResults(int rank, int size, int local_rows, const std::vector<int> &l
               displacements.data(), MPI_INT, kRootRank, MPI_COMM_WORLD);
 }
 
-bool SendRowsToProcess(int dest, int total_rows, int total_cols, int size,
-                       const std::vector<std::vector<int>> &original_input) {
-  auto [dest_start_row, dest_local_rows] = CalculateLocalRows(dest, size, total_rows);
-
-  if (dest_local_rows <= 0) {
-    return false;
-  }
-
-  std::array<int, 2> dest_info = {dest_local_rows, total_cols};
-  MPI_Send(dest_info.data(), 2, MPI_INT, dest, 0, MPI_COMM_WORLD);
-
-  for (int i = 0; i < dest_local_rows; ++i) {
-    int global_row = dest_start_row + i;
-    MPI_Send(original_input[static_cast<std::size_t>(global_row)].data(), total_cols, MPI_INT, dest, i + 1,
-             MPI_COMM_WORLD);
-  }
-
-  return true;
-}
-
-void ProcessRootData(int local_rows, int start_row, const std::vector<std::vector<int>> &original_input,
-                     std::vector<std::vector<int>> &local_input) {
-  local_input.reserve(static_cast<std::size_t>(local_rows));
-  for (int i = 0; i < local_rows; ++i) {
-    int global_row = start_row + i;
-    local_input.push_back(original_input[static_cast<std::size_t>(global_row)]);
+// Splits the rows into one contiguous block per rank, the remainder going to the first ranks
+std::vector<InType> SplitRows(const InType &input, int size, int total_rows) {
+  std::vector<InType> parts(static_cast<std::size_t>(size));
+  for (int dest = 0; dest < size; ++dest) {
+    auto [start_row, local_rows] = CalculateLocalRows(dest, size, total_rows);
+    parts[static_cast<std::size_t>(dest)].assign(input.begin() + start_row, input.begin() + start_row + local_rows);
   }
-}
-
-bool ReceiveRowsFromRoot(std::vector<std::vector<int>> &local_input) {
-  std::array<int, 2> recv_info = {0, 0};
-  MPI_Recv(recv_info.data(), 2, MPI_INT, kRootRank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-  int recv_rows = recv_info[0];
-  int recv_cols = recv_info[1];
-
-  if (recv_rows <= 0 || recv_cols <= 0) {
-    return false;
-  }
-
-  local_input.reserve(static_cast<std::size_t>(recv_rows));
-  for (int i = 0; i < recv_rows; ++i) {
-    std::vector<int> row(static_cast<std::size_t>(recv_cols));
-    MPI_Recv(row.data(), recv_cols, MPI_INT, kRootRank, i + 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-    local_input.push_back(std::move(row));
-  }
-
-  return true;
+  return parts;
 }
 
 }  // namespace
@@ -191,35 +150,12 @@ bool TrofimovNMaxValMatrixMPI::RunImpl() {
     return true;
   }
 
-  auto [start_row, local_rows] = CalculateLocalRows(rank, size, total_rows);
-
-  if (local_rows <= 0) {
-    HandleEmptyCase(rank, total_rows);
-    return true;
-  }
-
-  std::vector<std::vector<int>> local_input;
-
+  // All row blocks travel in one packed scatter instead of one message per row
+  std::vector<InType> parts;
   if (rank == kRootRank) {
-    const auto &original_input = GetInput();
-
-    for (int dest = 1; dest < size; ++dest) {
-      SendRowsToProcess(dest, total_rows, total_cols, size, original_input);
-    }
-
-    ProcessRootData(local_rows, start_row, original_input, local_input);
-  } else {
-    const bool received = ReceiveRowsFromRoot(local_input);
-    if (!received) {
-      HandleEmptyCase(rank, total_rows);
-      return true;
-    }
-  }
-
-  if (local_input.empty()) {
-    HandleEmptyCase(rank, total_rows);
-    return true;
+    parts = SplitRows(GetInput(), size, total_rows);
   }
+  const auto local_input = ppc::comm::Scatter<InType>(parts, kRootRank, MPI_COMM_WORLD);
 
   auto local_maxima = CalculateLocalMaxima(local_input);
   GatherResults(rank, size, static_cast<int>(local_input.size()), local_maxima, GetOutput(), total_rows);
@@ -14,6 +14,7 @@ class ZyazevaSVecDotProductMPI : public BaseTask {
   static constexpr ppc::task::TypeOfTask GetStaticTypeOfTask() {
     return ppc::task::TypeOfTask::kMPI;
   }
+  static constexpr bool kUsesTaskComm = true;
 
   explicit ZyazevaSVecDotProductMPI(std::vector<std::vector<int>> input)
       : ppc::task::Task<std::vector<std::vector<int>>, int64_t>() {
@@ -7,6 +7,7 @@
 #include <string>
 #include <tuple>
 
+#include "util/include/comm_groups.hpp"
 #include "util/include/func_test_util.hpp"
 #include "util/include/util.hpp"
 #include "zyazeva_s_vector_dot_product/common/include/common.hpp"
@@ -127,10 +128,12 @@ class ZyazevaRunFuncTestsMPI : public ppc::util::BaseRunFuncTests<InType, int64_
   }
 
   auto CheckTestOutputData(int64_t &output_data) -> bool final {  // NOLINT
-    int world_rank = 0;
-    MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
+    // The result lands on rank 0 of the communicator the task ran on, which is a group communicator when the world
+    // is split into PPC_COMM_GROUPS
+    int rank = 0;
+    MPI_Comm_rank(ppc::util::CommGroups::GetTestComm(), &rank);
 
-    if (world_rank == 0) {
+    if (rank == 0) {
       return (expected_output_ == output_data);
     }
     return true;